@@ -68,10 +68,8 @@ void AspPatchDialog::onClickAdd()
 {
     auto asp (ui->aspBox->currentData().toDouble());
     auto ang (aspTable_.getPlanetX2Table().at(key_).ang);
-    auto patch (AspTable::makePatch(person_.patch));
 
-    patch[key_] = {ang, asp, std::abs(ang - asp), 2};
-    person_.patch = AspTable::makePatch(patch);
+    person_.patch.insert(key_, {ang, asp, std::abs(ang - asp), 2});
 
     accept();
 }
@@ -79,10 +77,7 @@ void AspPatchDialog::onClickAdd()
 
 void AspPatchDialog::onClickDelete()
 {
-    auto patch (AspTable::makePatch(person_.patch));
-
-    patch.erase(key_);
-    person_.patch = AspTable::makePatch(patch);
+    person_.patch.erase(key_);
 
     accept();
 }
@@ -96,8 +91,7 @@ auto AspPatchDialog::execm(int row, int column) -> int
     key_ = {order[row], order[column]};
 
     auto& [key, data] (*table.find(key_));
-    auto  patch (AspTable::makePatch(person_.patch));
-    auto  isSet (contains(key, patch));
+    auto  isSet (person_.patch.contains(key));
 
     setWindowTitle(
         AstroBase::getPlanetName(key.less) + " : " +
@@ -1,6 +1,8 @@
 #include <QMessageBox>
 #include <QMenu>
 #include <QKeyEvent>
+#include <QClipboard>
+#include <QGuiApplication>
 #include "shared.h"
 #include "mask.h"
 #include "Kernel/Person.h"
@@ -52,6 +54,8 @@ AspTableDialog::AspTableDialog(
     connect(ui->actEdit, &QAction::triggered, this, &AspTableDialog::onClickEdit);
     connect(ui->actDelete, &QAction::triggered, this, &AspTableDialog::onClickDelete);
     connect(ui->actClear, &QAction::triggered, this, &AspTableDialog::onClickClear);
+    connect(ui->actCopy, &QAction::triggered, this, &AspTableDialog::onClickCopy);
+    connect(ui->actPaste, &QAction::triggered, this, &AspTableDialog::onClickPaste);
 
     connect(ui->table, &QTableWidget::cellDoubleClicked, this, &AspTableDialog::onCellDoubleClick);
     connect(ui->table, &QTableWidget::customContextMenuRequested, this, &AspTableDialog::onTableContext);
@@ -75,7 +79,6 @@ void AspTableDialog::reloadTable()
 
     auto row (0);
     auto size (planetOrder.size());
-    auto patch (aspTable_.makePatch(person_.patch));
 
     ui->table->clear();
     ui->table->setRowCount(size);
@@ -117,7 +120,7 @@ void AspTableDialog::reloadTable()
                 newItem->setText(view ? aspCatalog.at(data.asp) : roundTo(data.ang, 2));
                 newItem->setForeground(aspPen.at(data.asp).brush());
 
-                if (contains({i, j}, patch))
+                if (person_.patch.contains({i, j}))
                     newItem->setBackground(brush_[2]);
 
                 if (view)
@@ -156,15 +159,10 @@ void AspTableDialog::onClickDelete()
         return;
 
     auto& order (astroBase_.getPlanetOrder());
-    auto  patch (AspTable::makePatch(person_.patch));
-    auto  item (patch.find({order[row], order[column]}));
 
-    if (item != patch.end())
+    if (person_.patch.erase({order[row], order[column]}))
     {
-        patch.erase(item);
-        person_.patch = AspTable::makePatch(patch);
-
-        emit patchChanged(KernelMask::AspTableFull, CanvasMask::AspTableFull);
+        emit patchPairChanged(order[row], order[column]);
         emit personNeedSync();
 
         reloadTable();
@@ -202,6 +200,38 @@ void AspTableDialog::onClickClear()
 }
 
 
+void AspTableDialog::onClickCopy()
+{
+    if (!person_.patch.isEmpty())
+        QGuiApplication::clipboard()->setText(person_.patch.toString());
+}
+
+
+void AspTableDialog::onClickPaste()
+{
+    auto text (QGuiApplication::clipboard()->text().trimmed());
+    auto ok (true);
+    auto patch (AspPatch::fromString(text, &ok));
+
+    if (!ok || patch.isEmpty())
+    {
+        errorLog("bad patch " + text.left(80));
+        return;
+    }
+
+    person_.patch = patch;
+
+    emit patchChanged(KernelMask::AspTableFull, CanvasMask::AspTableFull);
+    emit personNeedSync();
+
+    auto row (ui->table->currentRow());
+    auto column (ui->table->currentColumn());
+
+    reloadTable();
+    ui->table->setCurrentCell(row, column);
+}
+
+
 void AspTableDialog::onCellDoubleClick(int row, int column)
 {
     if (row == column)
@@ -209,7 +239,8 @@ void AspTableDialog::onCellDoubleClick(int row, int column)
 
     if (patchDialog_->execm(row, column) == QDialog::Accepted)
     {
-        emit patchChanged(KernelMask::AspTableFull, CanvasMask::AspTableFull);
+        auto& order (astroBase_.getPlanetOrder());
+        emit patchPairChanged(order[row], order[column]);
         emit personNeedSync();
 
         reloadTable();
@@ -221,7 +252,6 @@ void AspTableDialog::onCellDoubleClick(int row, int column)
 void AspTableDialog::onTableContext(QPoint pos)
 {
     auto& order (astroBase_.getPlanetOrder());
-    auto  patch (AspTable::makePatch(person_.patch));
 
     auto row (ui->table->rowAt(pos.y()));
     auto column (ui->table->columnAt(pos.x()));
@@ -233,15 +263,19 @@ void AspTableDialog::onTableContext(QPoint pos)
     {
         menu->addAction(ui->actEdit);
 
-        if (contains(cell->first, patch))
+        if (person_.patch.contains(cell->first))
             menu->addAction(ui->actDelete);
     }
 
-    if (!patch.empty())
-    {
-        menu->addSeparator();
+    menu->addSeparator();
+
+    if (!person_.patch.isEmpty())
+        menu->addAction(ui->actCopy);
+
+    menu->addAction(ui->actPaste);
+
+    if (!person_.patch.isEmpty())
         menu->addAction(ui->actClear);
-    }
 
     if (!menu->isEmpty())
     {
@@ -262,6 +296,14 @@ auto AspTableDialog::keyPressEvent(QKeyEvent* event) -> void
     case Qt::Key_Delete :
         onClickDelete();
         break;
+    case Qt::Key_C :
+        if ((event->modifiers() & Qt::ControlModifier) != 0 && (event->modifiers() & Qt::ShiftModifier) != 0)
+            onClickCopy();
+        break;
+    case Qt::Key_V :
+        if ((event->modifiers() & Qt::ControlModifier) != 0 && (event->modifiers() & Qt::ShiftModifier) != 0)
+            onClickPaste();
+        break;
     case Qt::Key_R :
         if ((event->modifiers() & Qt::ControlModifier) != 0)
             onClickClear();
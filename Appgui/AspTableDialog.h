@@ -32,6 +32,7 @@ public :
 
 signals :
     void patchChanged(int kMask, int cMask);
+    void patchPairChanged(int keyA, int keyB);
     void personNeedSync();
 
 public slots :
@@ -41,6 +42,8 @@ private slots :
     void onClickEdit();
     void onClickDelete();
     void onClickClear();
+    void onClickCopy();
+    void onClickPaste();
     void onCellDoubleClick(int row, int column);
     void onTableContext(QPoint pos);
 
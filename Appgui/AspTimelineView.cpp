@@ -0,0 +1,242 @@
+#include <QtConcurrent>
+#include <QPainter>
+#include <QHelpEvent>
+#include <QToolTip>
+#include "shared.h"
+#include "Kernel/Person.h"
+#include "Kernel/AstroBase.h"
+#include "SharedGui.h"
+#include "AspTimelineView.h"
+
+namespace napatahti {
+
+AspTimelineView::AspTimelineView(
+    const Person&    person,
+    const AstroBase& astroBase,
+    const AspPage&   aspPage,
+    QWidget*         root
+    )
+    : QWidget(root)
+    , person_ (person)
+    , astroBase_ (astroBase)
+    , aspPage_ (aspPage)
+    , window_ {NONE, NONE}
+    , watcher_ (new QFutureWatcher<sweep_result_t>(this))
+    , days_ (30)
+    , pending_ (false)
+    , symFont_ ("HamburgSymbols", font().pointSize())
+{
+    setMouseTracking(true);
+
+    connect(watcher_, &QFutureWatcher<sweep_result_t>::finished, this, &AspTimelineView::onSweepFinished);
+}
+
+
+AspTimelineView::~AspTimelineView()
+{
+    watcher_->waitForFinished();
+}
+
+
+auto AspTimelineView::reload() -> void
+{
+    if (!isVisible())
+        return;
+
+    auto julDay (astroBase_.getJulDay());
+    window_ = {julDay - days_, julDay + days_};
+
+    launch();
+}
+
+
+auto AspTimelineView::setDays(int days) -> void
+{
+    days_ = days;
+    reload();
+}
+
+
+void AspTimelineView::onSweepFinished()
+{
+    for (auto& i : watcher_->result())
+        timeline_.merge(i.first, i.second);
+
+    if (pending_)
+    {
+        pending_ = false;
+        launch();
+        return;
+    }
+
+    timeline_.trim(window_);
+    makeRows();
+    update();
+}
+
+
+auto AspTimelineView::launch() -> void
+{
+    if (watcher_->isRunning())
+    {
+        pending_ = true;
+        return;
+    }
+
+    timeline_.setSource(makeSource());
+
+    // Only the part of the window which is not covered yet goes to the sweep
+    auto chunk (timeline_.missing(window_));
+    if (chunk.empty())
+    {
+        timeline_.trim(window_);
+        makeRows();
+        update();
+        return;
+    }
+
+    // A new source or a far jump empties the table, rows must not outlive their spans
+    makeRows();
+    update();
+
+    watcher_->setFuture(QtConcurrent::run([src = timeline_.getSource(), chunk]() {
+        sweep_result_t result;
+        for (auto& i : chunk)
+            result.emplace_back(i, AspTimeline::sweep(src, i));
+        return result;
+    }));
+}
+
+
+auto AspTimelineView::makeRows() -> void
+{
+    rows_.clear();
+
+    auto& planetOrder (astroBase_.getPlanetOrder());
+    auto& spanTable (timeline_.getSpanTable());
+
+    for (auto i (planetOrder.begin()); i != planetOrder.end(); ++i)
+        for (auto j (i + 1); j != planetOrder.end(); ++j)
+            if (contains(KeyPair(*i, *j), spanTable))
+                rows_.emplace_back(*i, *j);
+
+    setMinimumHeight(rowHeight_ * static_cast<int>(rows_.size() + 1));
+}
+
+
+auto AspTimelineView::makeSource() const -> AspTimelineSrc
+{
+    AspTimelineSrc src {astroBase_.getPlanetOrder(), {}, aspPage_.getOrbTable()};
+
+    for (auto& i : aspPage_.getAspEnb())
+        if (i.second)
+            src.asp.push_back(i.first);
+
+    return src;
+}
+
+
+auto AspTimelineView::toPosX(double julDay) const -> double
+{
+    return labelWidth_ + (width() - labelWidth_) * (julDay - window_[0]) / (window_[1] - window_[0]);
+}
+
+
+auto AspTimelineView::paintEvent(QPaintEvent* event) -> void
+{
+    Q_UNUSED(event)
+
+    QPainter painter (this);
+    painter.fillRect(rect(), palette().base());
+
+    if (window_[0] == NONE)
+        return;
+
+    auto& planetCatalog (astroBase_.getPlanetCatalog());
+    auto& spanTable (timeline_.getSpanTable());
+    auto& aspPen (aspPage_.getAspPen());
+
+    painter.setFont(symFont_);
+
+    auto posY (0);
+    for (auto& i : rows_)
+    {
+        painter.setPen(palette().text().color());
+        painter.drawText(
+            QRectF(0, posY, labelWidth_, rowHeight_), Qt::AlignCenter,
+            planetCatalog.at(i.less) + ' ' + planetCatalog.at(i.more));
+
+        for (auto& span : spanTable.at(i))
+        {
+            auto color (aspPen.at(span.asp).color());
+            QRectF spanRect (
+                QPointF(toPosX(std::max(span.begin, window_[0])), posY + 3),
+                QPointF(toPosX(std::min(span.end, window_[1])), posY + rowHeight_ - 3));
+
+            color.setAlpha(96);
+            painter.fillRect(spanRect, color);
+
+            color.setAlpha(255);
+            painter.setPen(color);
+            painter.drawLine(QPointF(toPosX(span.exact), spanRect.top()),
+                             QPointF(toPosX(span.exact), spanRect.bottom()));
+        }
+
+        posY += rowHeight_;
+    }
+
+    auto posX (toPosX(astroBase_.getJulDay()));
+    painter.setPen(palette().highlight().color());
+    painter.drawLine(QPointF(posX, 0), QPointF(posX, height()));
+}
+
+
+auto AspTimelineView::event(QEvent* event) -> bool
+{
+    if (event->type() != QEvent::ToolTip)
+        return QWidget::event(event);
+
+    auto helpEvent (static_cast<QHelpEvent*>(event));
+    auto row (helpEvent->pos().y() / rowHeight_);
+
+    if (row >= static_cast<int>(rows_.size()) || helpEvent->pos().x() < labelWidth_)
+    {
+        QToolTip::hideText();
+        event->ignore();
+        return true;
+    }
+
+    auto& key (rows_[row]);
+    auto  julDay (window_[0] + (helpEvent->pos().x() - labelWidth_) *
+                  (window_[1] - window_[0]) / (width() - labelWidth_));
+
+    for (auto& span : timeline_.getSpanTable().at(key))
+    {
+        if (julDay < span.begin || julDay > span.end)
+            continue;
+
+        auto& locale (SharedGui::getAppLocale());
+        auto  utc (person_.dateTime.offsetFromUtc());
+        auto  format (locale.dateTimeFormat(QLocale::ShortFormat));
+
+        QToolTip::showText(
+            helpEvent->globalPos(),
+            QString("%1 - %2 : %3\n%4\n%5\n%6")
+                .arg(AstroBase::getPlanetName(key.less))
+                .arg(AstroBase::getPlanetName(key.more))
+                .arg(roundTo(span.asp, 2))
+                .arg(locale.toString(AstroBase::revJulDay(span.begin, utc), format))
+                .arg(locale.toString(AstroBase::revJulDay(span.exact, utc), format))
+                .arg(locale.toString(AstroBase::revJulDay(span.end, utc), format)),
+            this);
+
+        return true;
+    }
+
+    QToolTip::hideText();
+    event->ignore();
+
+    return true;
+}
+
+} // namespace napatahti
@@ -0,0 +1,66 @@
+#ifndef ASPTIMELINEVIEW_H
+#define ASPTIMELINEVIEW_H
+
+#include <QWidget>
+#include <QFutureWatcher>
+#include "Kernel/AspTimeline.h"
+
+namespace napatahti {
+
+class Person;
+class AstroBase;
+class AspPage;
+
+
+class AspTimelineView : public QWidget
+{
+    Q_OBJECT
+
+    using sweep_result_t = std::vector<std::pair<AspTimeline::range_t, AspTimeline::span_table_t>>;
+
+public :
+    explicit AspTimelineView(
+        const Person&    person,
+        const AstroBase& astroBase,
+        const AspPage&   aspPage,
+        QWidget*         root=nullptr);
+
+    ~AspTimelineView();
+
+    auto reload() -> void;
+    auto setDays(int days) -> void;
+
+private slots :
+    void onSweepFinished();
+
+private :
+    const Person&    person_;
+    const AstroBase& astroBase_;
+    const AspPage&   aspPage_;
+
+    AspTimeline timeline_;
+    AspTimeline::range_t window_;
+    QFutureWatcher<sweep_result_t>* watcher_;
+    std::vector<KeyPair> rows_;
+
+    int  days_;
+    bool pending_;
+
+    QFont symFont_;
+
+    static constexpr int labelWidth_ {56};
+    static constexpr int rowHeight_ {20};
+
+private :
+    auto launch() -> void;
+    auto makeRows() -> void;
+    auto makeSource() const -> AspTimelineSrc;
+    auto toPosX(double julDay) const -> double;
+
+    auto paintEvent(QPaintEvent* event) -> void;
+    auto event(QEvent* event) -> bool;
+};
+
+} // namespace napatahti
+
+#endif // ASPTIMELINEVIEW_H
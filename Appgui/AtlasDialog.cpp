@@ -1,10 +1,19 @@
+#include <cmath>
+#include <algorithm>
 #include <QMenu>
+#include <QtMath>
 #include <QMessageBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QProgressDialog>
 #include <QKeyEvent>
 #include <QSqlQuery>
 #include <QSqlError>
 #include "shared.h"
+#include "Kernel/RefBook.h"
 #include "CityDialog.h"
+#include "CityModel.h"
+#include "CityImport.h"
 #include "AtlasDialog.h"
 #include "ui_AtlasDialog.h"
 
@@ -13,100 +22,173 @@ namespace napatahti {
 AtlasDialog::AtlasDialog(QWidget* root)
     : QDialog (root)
     , ui (new Ui::AtlasDialog)
-    , dbase_ (QSqlDatabase::addDatabase("QSQLITE", "AtlasDialog"))
+    , dbase_ ("AtlasDialog", dbaseName_)
+    , model_ (new CityModel(dbase_, this))
+    , isLoaded_ (false)
+    , isSpatial_ (false)
 {
     ui->setupUi(this);
     setLocale(locale_);
 
+    ui->table->setModel(model_);
     ui->table->horizontalHeader()->setVisible(true);
+    ui->table->horizontalHeader()->setSortIndicator(0, Qt::AscendingOrder);
     ui->table->setColumnWidth(0, 400);
     ui->table->setColumnWidth(1, 100);
     ui->table->setColumnWidth(2, 150);
     ui->table->setColumnWidth(3, 150);
 
-    //-------------------------------------------------------------------------//
+    // Nothing is read from the base here, the atlas
+    // is loaded on first use, see load()
+
+    connect(ui->selectLine, &QLineEdit::textChanged, this, &AtlasDialog::onTextChange);
+    connect(ui->table, &QTableView::doubleClicked, this, &AtlasDialog::onSelectCity);
+    connect(ui->table, &QTableView::customContextMenuRequested, this, &AtlasDialog::onContextMenu);
+
+    connect(ui->actionSelect, &QAction::triggered, this, &AtlasDialog::onSelectCity);
+    connect(ui->actionNew, &QAction::triggered, this, [this](){ execCityDialog(false); });
+    connect(ui->actionEdit, &QAction::triggered, this, [this](){ execCityDialog(true); });
+    connect(ui->actionDelete, &QAction::triggered, this, &AtlasDialog::onDeleteCity);
+    connect(ui->actionImport, &QAction::triggered, this, &AtlasDialog::onImport);
+}
 
-    dbase_.setDatabaseName(dbaseName_);
 
-    if (dbase_.open())
+AtlasDialog::~AtlasDialog()
+{
+    delete ui;
+}
+
+
+auto AtlasDialog::findCity(const QString& title) -> std::optional<CityModel::City>
+{
+    if (title.isEmpty() || !load())
+        return {};
+
+    // Titles are matched by their lowercase key, the first city of a title wins
+    auto& query (dbase_.prepare(mask_.find));
+    query.addBindValue(toKey(title));
+
+    std::optional<CityModel::City> res;
+
+    if (!query.exec())
+        errorLog("Can not search " + dbaseName_ + " : " + query.lastError().text());
+    else if (query.next())
+        res = CityModel::City {
+            query.value("title").toString(),
+            query.value("utc").toInt(),
+            query.value("lat").toInt(),
+            query.value("lon").toInt()
+        };
+
+    query.finish();
+
+    return res;
+}
+
+
+auto AtlasDialog::findNearest(int lat, int lon, int count) -> std::vector<CityModel::City>
+{
+    std::vector<std::pair<double, CityModel::City>> near;
+
+    if (count < 1 || !load())
+        return {};
+
+    constexpr auto full (180 * 3600);
+    constexpr auto pole (90 * 3600);
+
+    // The box grows until the cities found in it are
+    // closer than any city left outside of it
+    for (auto radius (nearRadius_); ; radius = std::min(2 * radius, full))
     {
-        dbase_.exec("CREATE TABLE IF NOT EXISTS base ("
-                        "title BLOB, utc BLOB, lat BLOB, lon BLOB, "
-                        "PRIMARY KEY (title, utc));");
+        auto phi (qDegreesToRadians(lat / 3600.0));
+        auto arc (qDegreesToRadians(radius / 3600.0));
 
-        auto query (dbase_.exec("SELECT * FROM base ORDER BY title ASC"));
-        auto row (0);
+        // The longitude span of a circle widens towards the poles
+        auto span (lat + radius >= pole || lat - radius <= -pole || std::sin(arc) >= std::cos(phi)
+            ? full
+            : static_cast<int>(3600 * qRadiansToDegrees(std::asin(std::sin(arc) / std::cos(phi)))) + 1);
 
-        ui->table->setSortingEnabled(false);
+        near.clear();
 
-        while (query.next())
-        {
-            ui->table->setRowCount(row + 1);
+        for (auto& i : findInBox(lat - radius, lat + radius, lon - span, lon + span))
+            near.emplace_back(distance(lat, lon, i.lat, i.lon), i);
 
-            auto newItem (new QTableWidgetItem(query.value("title").toString()));
-            ui->table->setItem(row, 0, newItem);
+        auto size (std::min<std::size_t>(count, near.size()));
 
-            newItem = new QTableWidgetItem(toStrUtc(query.value("utc").toInt(), false));
-            newItem->setTextAlignment(Qt::AlignCenter);
-            ui->table->setItem(row, 1, newItem);
+        std::partial_sort(near.begin(), near.begin() + size, near.end(), [](auto& lhs, auto& rhs) {
+            return lhs.first < rhs.first;
+        });
 
-            newItem = new QTableWidgetItem(toStrCrd(query.value("lat").toInt(), true));
-            ui->table->setItem(row, 2, newItem);
-            newItem->setTextAlignment(Qt::AlignCenter);
+        if (radius == full || (size == static_cast<std::size_t>(count) && near[size - 1].first <= radius))
+        {
+            std::vector<CityModel::City> res;
 
-            newItem = new QTableWidgetItem(toStrCrd(query.value("lon").toInt(), false));
-            ui->table->setItem(row, 3, newItem);
-            newItem->setTextAlignment(Qt::AlignCenter);
+            for (auto i (0u); i < size; ++i)
+                res.push_back(near[i].second);
 
-            ++row;
+            return res;
         }
+    }
+}
+
+
+auto AtlasDialog::findInBox(int minLat, int maxLat, int minLon, int maxLon) -> std::vector<CityModel::City>
+{
+    constexpr auto full (180 * 3600);
 
-        ui->table->setSortingEnabled(true);
-        dbase_.close();
+    std::vector<CityModel::City> res;
+
+    if (!load())
+        return res;
+
+    // A box across the antimeridian is queried as two boxes
+    if (maxLon - minLon >= 2 * full)
+    {
+        minLon = -full;
+        maxLon = full;
+    }
+    else if (minLon < -full)
+    {
+        res = findInBox(minLat, maxLat, minLon + 2 * full, full);
+        minLon = -full;
+    }
+    else if (maxLon > full)
+    {
+        res = findInBox(minLat, maxLat, -full, maxLon - 2 * full);
+        maxLon = full;
     }
-    else
-        errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
 
-    //-------------------------------------------------------------------------//
+    auto& query (dbase_.prepare(isSpatial_ ? mask_.box : mask_.plainBox));
 
-    connect(ui->selectLine, &QLineEdit::textChanged, this, &AtlasDialog::onTextChange);
-    connect(ui->table, &QTableWidget::cellDoubleClicked, this, &AtlasDialog::onSelectCity);
-    connect(ui->table, &QTableWidget::customContextMenuRequested, this, &AtlasDialog::onContextMenu);
+    query.addBindValue(minLat);
+    query.addBindValue(maxLat);
+    query.addBindValue(minLon);
+    query.addBindValue(maxLon);
 
-    connect(ui->actionSelect, &QAction::triggered, this, &AtlasDialog::onSelectCity);
-    connect(ui->actionNew, &QAction::triggered, this, [this](){ execCityDialog(false); });
-    connect(ui->actionEdit, &QAction::triggered, this, [this](){ execCityDialog(true); });
-    connect(ui->actionDelete, &QAction::triggered, this, &AtlasDialog::onDeleteCity);
-}
+    if (query.exec())
+        while (query.next())
+            res.push_back({
+                query.value("title").toString(),
+                query.value("utc").toInt(),
+                query.value("lat").toInt(),
+                query.value("lon").toInt()
+            });
+    else
+        errorLog("Can not search " + dbaseName_ + " : " + query.lastError().text());
 
+    query.finish();
 
-AtlasDialog::~AtlasDialog()
-{
-    delete ui;
+    return res;
 }
 
 
 void AtlasDialog::onTextChange(const QString& text)
 {
     ui->table->clearSelection();
-    ui->table->setCurrentCell(-1, -1);
+    ui->table->setCurrentIndex({});
 
     if (!text.isEmpty())
-    {
-        auto match (ui->table->findItems(text, Qt::MatchStartsWith));
-        if (!match.isEmpty())
-        {
-            auto row (match[0]->row());
-            auto item (ui->table->item(row, 0));
-
-            ui->table->scrollToItem(item);
-            ui->table->setCurrentItem(item);
-            item->setSelected(true);
-            ui->table->item(row, 1)->setSelected(true);
-            ui->table->item(row, 2)->setSelected(true);
-            ui->table->item(row, 3)->setSelected(true);
-        }
-    }
+        selectRow(model_->findText(text));
 }
 
 
@@ -114,7 +196,7 @@ void AtlasDialog::onContextMenu(QPoint pos)
 {
     auto menu (new QMenu(this));
 
-    if (ui->table->itemAt(pos) != nullptr)
+    if (ui->table->indexAt(pos).isValid())
     {
         if (selectedRows().size() > 1)
         {
@@ -132,6 +214,8 @@ void AtlasDialog::onContextMenu(QPoint pos)
     else
         menu->addAction(ui->actionNew);
 
+    menu->addAction(ui->actionImport);
+
     pos.ry() += ui->table->horizontalHeader()->height();
     menu->exec(ui->table->mapToGlobal(pos));
 }
@@ -146,68 +230,49 @@ void AtlasDialog::onSelectCity()
 
 void AtlasDialog::onUpdateBase(const QVariantMap& data)
 {
-    if (!dbase_.open())
-    {
-        errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
+    if (!load())
         return;
-    }
-
-    auto query (dbase_.exec());
 
-    ui->table->setSortingEnabled(false);
+    auto title (data["title"].toString());
+    auto utc (toIntUtc(data["utc"].toString()));
+    auto resp (false);
 
     if (data["mode"].toBool())
     {
-        auto row (ui->table->currentRow());
+        auto city (model_->getCity(ui->table->currentIndex().row()));
+        if (city == nullptr)
+            return;
+
+        auto& query (dbase_.prepare(mask_.update));
 
-        query.prepare("UPDATE base SET title=?, utc=?, lat=?, lon=? WHERE title=? AND utc=?;");
-        query.addBindValue(data["title"]);
-        query.addBindValue(toIntUtc(data["utc"].toString()));
+        query.addBindValue(title);
+        query.addBindValue(toKey(title));
+        query.addBindValue(utc);
         query.addBindValue(toIntCrd(data["lat"].toString()));
         query.addBindValue(toIntCrd(data["lon"].toString()));
-        query.addBindValue(ui->table->item(row, 0)->text());
-        query.addBindValue(toIntUtc(ui->table->item(row, 1)->text()));
+        query.addBindValue(city->title);
+        query.addBindValue(city->utc);
 
-        if (query.exec())
-        {
-            ui->table->item(row, 0)->setText(data["title"].toString());
-            ui->table->item(row, 1)->setText(data["utc"].toString());
-            ui->table->item(row, 2)->setText(data["lat"].toString());
-            ui->table->item(row, 3)->setText(data["lon"].toString());
-        }
+        resp = query.exec();
     }
     else
     {
-        query.prepare("INSERT INTO base (title, utc, lat, lon) VALUES (?, ?, ?, ?);");
-        query.addBindValue(data["title"]);
-        query.addBindValue(toIntUtc(data["utc"].toString()));
+        auto& query (dbase_.prepare(mask_.insert));
+
+        query.addBindValue(title);
+        query.addBindValue(toKey(title));
+        query.addBindValue(utc);
         query.addBindValue(toIntCrd(data["lat"].toString()));
         query.addBindValue(toIntCrd(data["lon"].toString()));
 
-        if (query.exec())
-        {
-            auto row (ui->table->rowCount());
-            ui->table->setRowCount(row + 1);
-
-            auto newItem (new QTableWidgetItem(data["title"].toString()));
-            ui->table->setItem(row, 0, newItem);
-
-            newItem = new QTableWidgetItem(data["utc"].toString());
-            newItem->setTextAlignment(Qt::AlignCenter);
-            ui->table->setItem(row, 1, newItem);
-
-            newItem = new QTableWidgetItem(data["lat"].toString());
-            ui->table->setItem(row, 2, newItem);
-            newItem->setTextAlignment(Qt::AlignCenter);
-
-            newItem = new QTableWidgetItem(data["lon"].toString());
-            ui->table->setItem(row, 3, newItem);
-            newItem->setTextAlignment(Qt::AlignCenter);
-        }
+        resp = query.exec();
     }
 
-    ui->table->setSortingEnabled(true);
-    dbase_.close();
+    if (resp)
+    {
+        model_->reload();
+        selectRow(model_->findRow(title, utc));
+    }
 }
 
 
@@ -218,9 +283,18 @@ void AtlasDialog::onDeleteCity()
     if (rows.empty())
         return;
 
-    auto part (rows.size() == 1
-        ? ui->table->item(*rows.begin(), 0)->text() + ", " +
-          ui->table->item(*rows.begin(), 1)->text()
+    // The keys are copied, pages of the model are dropped on reload
+    std::vector<CityModel::City> erased;
+
+    for (auto i : rows)
+        if (auto city (model_->getCity(i)); city != nullptr)
+            erased.push_back(*city);
+
+    if (erased.empty())
+        return;
+
+    auto part (erased.size() == 1
+        ? erased[0].title + ", " + toStrUtc(erased[0].utc, false)
         : tr("selected rows"));
 
     auto msgBox (new QMessageBox(
@@ -239,25 +313,87 @@ void AtlasDialog::onDeleteCity()
             return;
         }
 
-        auto query (dbase_.exec());
+        auto& query (dbase_.prepare(mask_.erase));
 
-        for (auto i (rows.rbegin()); i != rows.rend(); ++i)
-        {
-            query.prepare("DELETE FROM base WHERE title=? AND utc=?");
-            query.addBindValue(ui->table->item(*i, 0)->text());
-            query.addBindValue(toIntUtc(ui->table->item(*i, 1)->text()));
+        dbase_.transaction();
 
-            if (query.exec())
-                ui->table->removeRow(*i);
+        for (auto& i : erased)
+        {
+            query.addBindValue(i.title);
+            query.addBindValue(i.utc);
+            query.exec();
         }
 
-        dbase_.close();
+        dbase_.commit();
+        model_->reload();
     }
 }
 
 
+void AtlasDialog::onImport()
+{
+    if (!load())
+        return;
+
+    auto fileName (QFileDialog::getOpenFileName(
+        this, tr("Import"), "", tr("GeoNames dump (*.txt *.tsv);;All files (*)")));
+
+    if (fileName.isEmpty())
+        return;
+
+    auto progress (new QProgressDialog(
+        tr("Import") + ' ' + QFileInfo(fileName).fileName() + "...", tr("Cancel"), 0, 1000, this));
+
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(500);
+
+    // Triggers would update both indexes on every row,
+    // they are dropped and built once after the import
+    dbase_.dropIndex("city");
+    dbase_.forget();
+
+    auto query (dbase_.exec());
+    for (auto& i : mask_.dropSpatial)
+        query.exec(i);
+
+    CityImport import (dbase_);
+
+    auto report (import.exec(fileName, [progress](double part) {
+        progress->setValue(static_cast<int>(1000 * part));
+        return !progress->wasCanceled();
+    }));
+
+    progress->setLabelText(tr("Indexing..."));
+    progress->setCancelButton(nullptr);
+    progress->setRange(0, 0);
+
+    model_->setIndexed(dbase_.makeIndex("city", {"title"}));
+    isSpatial_ = makeSpatial();
+
+    delete progress;
+    model_->reload();
+
+    auto msgBox (new QMessageBox(
+        QMessageBox::Information, tr("Import"),
+        (report.canceled ? tr("Import canceled") + "\n\n" : QString()) +
+        tr("Rows read") + " : " + QString::number(report.read) + '\n' +
+        tr("Inserted") + " : " + QString::number(report.inserted) + '\n' +
+        tr("Duplicates") + " : " + QString::number(report.duplicate) + '\n' +
+        tr("Skipped") + " : " + QString::number(report.skipped) + '\n' +
+        tr("Time") + " : " + QString::number(report.msecs / 1000.0, 'f', 1) + tr(" s") + ", " +
+        QString::number(qRound(report.rate())) + tr(" rows/s"),
+        QMessageBox::Ok, this));
+
+    msgBox->setAttribute(Qt::WA_WindowPropagation, true);
+    msgBox->setWindowIcon(QIcon(":/24x24/compass.png"));
+    msgBox->exec();
+}
+
+
 auto AtlasDialog::showEvent(QShowEvent*) -> void
 {
+    load();
+
     ui->table->scrollToTop();
 
     if (!ui->selectLine->text().isEmpty())
@@ -265,7 +401,7 @@ auto AtlasDialog::showEvent(QShowEvent*) -> void
     else
     {
         ui->table->clearSelection();
-        ui->table->setCurrentCell(-1, -1);
+        ui->table->setCurrentIndex({});
     }
 
     ui->selectLine->setFocus();
@@ -294,12 +430,129 @@ auto AtlasDialog::keyPressEvent(QKeyEvent* event) -> void
         if ((event->modifiers() & Qt::ControlModifier) != 0 && selectedRows().size() == 1)
             execCityDialog(true);
         break;
+    case Qt::Key_I :
+        if ((event->modifiers() & Qt::ControlModifier) != 0)
+            onImport();
+        break;
     default :
         QDialog::keyPressEvent(event);
     }
 }
 
 
+auto AtlasDialog::load() -> bool
+{
+    if (isLoaded_)
+        return true;
+
+    if (!dbase_.open())
+    {
+        errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
+        return false;
+    }
+
+    // Only the row count is read here, the cities are fetched
+    // in pages as they are shown
+    migrate();
+    model_->setIndexed(dbase_.makeIndex("city", {"title"}));
+    isSpatial_ = makeSpatial();
+    model_->reload();
+
+    isLoaded_ = true;
+
+    return true;
+}
+
+
+auto AtlasDialog::migrate() -> void
+{
+    if (dbase_.getVersion() >= version_)
+        return;
+
+    dbase_.transaction();
+
+    auto query (dbase_.exec());
+    auto resp (true);
+
+    for (auto& i : mask_.schema)
+        resp = resp && query.exec(i);
+
+    // Version 0 kept the cities untyped in the base table
+    if (resp && dbase_.hasTable("base"))
+    {
+        dbase_.dropIndex("base");
+        resp = query.exec(mask_.move) && query.exec(mask_.dropLegacy);
+    }
+
+    // Version 3 had no title key, SQLite folds ASCII only, so the key is filled here
+    if (resp && !(query.exec(mask_.hasKey) && query.next()))
+        resp = query.exec(mask_.addKey);
+
+    resp = resp && fillKeys() && query.exec(mask_.keyIndex) && dbase_.setVersion(version_);
+
+    if (resp && dbase_.commit())
+        return;
+
+    errorLog("Can not migrate " + dbaseName_ + " : " + query.lastError().text());
+    dbase_.rollback();
+}
+
+
+auto AtlasDialog::fillKeys() -> bool
+{
+    std::vector<std::pair<qint64, QString>> key;
+    auto query (dbase_.exec());
+
+    if (!query.exec(mask_.noKey))
+        return false;
+
+    while (query.next())
+        key.emplace_back(query.value(0).toLongLong(), toKey(query.value(1).toString()));
+
+    auto& update (dbase_.prepare(mask_.setKey));
+
+    for (auto& i : key)
+    {
+        update.addBindValue(i.second);
+        update.addBindValue(i.first);
+
+        if (!update.exec())
+        {
+            errorLog("Can not migrate " + dbaseName_ + " : " + update.lastError().text());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+auto AtlasDialog::makeSpatial() -> bool
+{
+    if (dbase_.hasTable("city_rtree"))
+        return true;
+
+    dbase_.forget();
+    dbase_.transaction();
+
+    // The tree holds every city as a point box, its triggers
+    // keep it in step with the city table
+    auto query (dbase_.exec());
+    auto resp (true);
+
+    for (auto& i : mask_.spatial)
+        resp = resp && query.exec(i);
+
+    if (resp && dbase_.commit())
+        return true;
+
+    errorLog("Can not index " + dbaseName_ + " : " + query.lastError().text());
+    dbase_.rollback();
+
+    return false;
+}
+
+
 auto AtlasDialog::execCityDialog(bool mode) -> void
 {
     auto dialog (new CityDialog(getCityData(mode), this));
@@ -311,16 +564,17 @@ auto AtlasDialog::execCityDialog(bool mode) -> void
 
 auto AtlasDialog::getCityData(int mode) -> QVariantMap
 {
-    if (mode > 0)
+    auto city (mode > 0 ? model_->getCity(ui->table->currentIndex().row()) : nullptr);
+
+    if (city != nullptr)
     {
-        auto row (ui->table->currentRow());
-        auto utc (ui->table->item(row, 1)->text());
+        auto utc (toStrUtc(city->utc, false));
 
         QVariantMap data {
-            {"title", ui->table->item(row, 0)->text()},
+            {"title", city->title},
             {"utc", utc == "UTC" ? "+00:00" : utc},
-            {"lat", ui->table->item(row, 2)->text()},
-            {"lon", ui->table->item(row, 3)->text()}
+            {"lat", toStrCrd(city->lat, true)},
+            {"lon", toStrCrd(city->lon, false)}
         };
 
         if (mode == 1)
@@ -337,11 +591,34 @@ auto AtlasDialog::selectedRows() const -> std::set<int>
 {
     std::set<int> res;
 
-    for (auto& i : ui->table->selectedRanges())
-        for (auto j (i.topRow()); j <= i.bottomRow(); ++j)
-            res.insert(j);
+    for (auto& i : ui->table->selectionModel()->selectedRows())
+        res.insert(i.row());
 
     return res;
 }
 
+
+auto AtlasDialog::selectRow(int row) -> void
+{
+    if (row < 0)
+        return;
+
+    ui->table->scrollTo(model_->index(row, 0));
+    ui->table->selectRow(row);
+}
+
+
+auto AtlasDialog::distance(int lat1, int lon1, int lat2, int lon2) -> double
+{
+    auto phi1 (qDegreesToRadians(lat1 / 3600.0));
+    auto phi2 (qDegreesToRadians(lat2 / 3600.0));
+    auto dPhi (std::sin((phi2 - phi1) / 2));
+    auto dLambda (std::sin(qDegreesToRadians((lon2 - lon1) / 3600.0) / 2));
+
+    // Central angle by haversine, in arc-seconds as the coordinates
+    auto hav (dPhi * dPhi + std::cos(phi1) * std::cos(phi2) * dLambda * dLambda);
+
+    return 3600 * qRadiansToDegrees(2 * std::asin(std::sqrt(std::min(hav, 1.0))));
+}
+
 } // namespace napatahti
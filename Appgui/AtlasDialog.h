@@ -2,9 +2,11 @@
 #define ATLASDIALOG_H
 
 #include <set>
+#include <optional>
 #include <QDialog>
-#include <QSqlDatabase>
 #include "SharedGui.h"
+#include "SqlConnection.h"
+#include "CityModel.h"
 
 namespace Ui {
 class AtlasDialog;
@@ -23,33 +25,97 @@ public :
     explicit AtlasDialog(QWidget* root=nullptr);
     ~AtlasDialog();
 
+    auto findCity(const QString& title) -> std::optional<CityModel::City>;
+    auto findNearest(int lat, int lon, int count=1) -> std::vector<CityModel::City>;
+    auto findInBox(int minLat, int maxLat, int minLon, int maxLon) -> std::vector<CityModel::City>;
+
+    static auto toKey(const QString& title) { return title.toLower(); }
+
 signals :
     void citySelected(const QVariantMap& city);
 
 public slots :
     void onUpdateBase(const QVariantMap& data);
 
+public :
+    struct SqlMask {
+        QStringList schema {
+            "CREATE TABLE IF NOT EXISTS city ("
+                "id INTEGER PRIMARY KEY, title TEXT NOT NULL, utc INTEGER NOT NULL, "
+                "lat INTEGER NOT NULL, lon INTEGER NOT NULL, title_key TEXT NOT NULL DEFAULT '', "
+                "UNIQUE (title, utc));",
+            "CREATE INDEX IF NOT EXISTS city_title ON city (title);",
+            "DROP INDEX IF EXISTS city_title_nocase;"};
+        QString hasKey {"SELECT 1 FROM pragma_table_info('city') WHERE name='title_key';"};
+        QString addKey {"ALTER TABLE city ADD COLUMN title_key TEXT NOT NULL DEFAULT '';"};
+        QString noKey {"SELECT id, title FROM city WHERE title_key='';"};
+        QString setKey {"UPDATE city SET title_key=? WHERE id=?;"};
+        QString keyIndex {"CREATE INDEX IF NOT EXISTS city_title_key ON city (title_key);"};
+        QString move {"INSERT OR IGNORE INTO city (title, utc, lat, lon) "
+                          "SELECT CAST(title AS TEXT), CAST(utc AS INTEGER), "
+                          "CAST(lat AS INTEGER), CAST(lon AS INTEGER) FROM base;"};
+        QString dropLegacy {"DROP TABLE base;"};
+        QString find {"SELECT title, utc, lat, lon FROM city WHERE title_key=? ORDER BY id LIMIT 1;"};
+        QString insert {"INSERT INTO city (title, title_key, utc, lat, lon) VALUES (?, ?, ?, ?, ?);"};
+        QString update {"UPDATE city SET title=?, title_key=?, utc=?, lat=?, lon=? WHERE title=? AND utc=?;"};
+        QString erase {"DELETE FROM city WHERE title=? AND utc=?;"};
+        QStringList spatial {
+            "CREATE VIRTUAL TABLE city_rtree USING rtree_i32(id, minLat, maxLat, minLon, maxLon);",
+            "CREATE TRIGGER city_rtree_ai AFTER INSERT ON city BEGIN "
+                "INSERT INTO city_rtree VALUES (new.id, new.lat, new.lat, new.lon, new.lon); END;",
+            "CREATE TRIGGER city_rtree_ad AFTER DELETE ON city BEGIN "
+                "DELETE FROM city_rtree WHERE id=old.id; END;",
+            "CREATE TRIGGER city_rtree_au AFTER UPDATE ON city BEGIN "
+                "DELETE FROM city_rtree WHERE id=old.id; "
+                "INSERT INTO city_rtree VALUES (new.id, new.lat, new.lat, new.lon, new.lon); END;",
+            "INSERT INTO city_rtree SELECT id, lat, lat, lon, lon FROM city;"};
+        QStringList dropSpatial {
+            "DROP TRIGGER IF EXISTS city_rtree_ai;",
+            "DROP TRIGGER IF EXISTS city_rtree_ad;",
+            "DROP TRIGGER IF EXISTS city_rtree_au;",
+            "DROP TABLE IF EXISTS city_rtree;"};
+        QString box {"SELECT c.title, c.utc, c.lat, c.lon FROM city_rtree r JOIN city c ON c.id = r.id "
+                     "WHERE r.maxLat >= ? AND r.minLat <= ? AND r.maxLon >= ? AND r.minLon <= ?;"};
+        QString plainBox {"SELECT title, utc, lat, lon FROM city "
+                          "WHERE lat BETWEEN ? AND ? AND lon BETWEEN ? AND ?;"};
+    };
+
 private :
     Ui::AtlasDialog* ui;
 
-    QSqlDatabase dbase_;
+    SqlConnection dbase_;
+    CityModel* model_;
+    bool isLoaded_;
+    bool isSpatial_;
 
+    static const SqlMask mask_;
     static QString dbaseName_;
     static QVariantMap newCity_;
 
+    static constexpr int version_ {4};
+    static constexpr int nearRadius_ {1800};
+
 private slots :
     void onTextChange(const QString& text);
     void onContextMenu(QPoint pos);
     void onSelectCity();
     void onDeleteCity();
+    void onImport();
 
 private :
     auto showEvent(QShowEvent*) -> void;
     auto keyPressEvent(QKeyEvent* event) -> void;
 
+    auto load() -> bool;
+    auto migrate() -> void;
+    auto fillKeys() -> bool;
+    auto makeSpatial() -> bool;
     auto execCityDialog(bool mode) -> void;
     auto getCityData(int mode=2) -> QVariantMap;
     auto selectedRows() const -> std::set<int>;
+    auto selectRow(int row) -> void;
+
+    static auto distance(int lat1, int lon1, int lat2, int lon2) -> double;
 
     friend ConfigDialog;
     friend auto staticInit(QApplication& app) -> void;
@@ -1,4 +1,7 @@
 #include <QTimer>
+#include <QPainter>
+#include <QPicture>
+#include <QFontMetricsF>
 #include "mask.h"
 #include "shared.h"
 #include "Kernel/Kernel.h"
@@ -12,24 +15,59 @@ Canvas::Canvas(const Kernel& kernel, QWidget* root)
     : QGraphicsView (root)
     , kernel_ (kernel)
     , trigger_ (MainWindow::getTrigger())
-    , scene_ (new QGraphicsScene)
+    , scene_ (new QGraphicsScene(this))
+    , baseScene_ (new QGraphicsScene(this))
+    , baseItem_ (new QGraphicsPixmapItem)
+    , baseStamp_ (0)
+    , baseScale_ (0)
+    , aspect_ (0)
+    , isTrace_ (false)
+    , marked_ (nullptr)
 {
+    // Layers move their items on every render and know them through their pools,
+    // keeping a BSP tree in step would cost more than the few point lookups it saves
+    scene_->setItemIndexMethod(QGraphicsScene::NoIndex);
+
     setFrameShape(QFrame::NoFrame);
     setStyleSheet(colorSrc_.baseBkg());
     setRenderHint(QPainter::Antialiasing);
     setContextMenuPolicy(Qt::ContextMenuPolicy::CustomContextMenu);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
 
+    // Markers have no pool of their own, each configuration keeps one
+    auto pool (pool_.begin());
     for (auto& i : group_)
     {
         i = new QGraphicsItemGroup;
         scene_->addItem(i);
+
+        if (pool != pool_.end())
+            *pool++ = ItemPool(i);
     }
 
     setScene(scene_);
 
+    // The zodiac ring is kept off screen and shown as a pixmap under the circle
+    auto baseGroup (new QGraphicsItemGroup);
+    baseScene_->setItemIndexMethod(QGraphicsScene::NoIndex);
+    baseScene_->addItem(baseGroup);
+    basePool_ = ItemPool(baseGroup);
+
+    baseItem_->setZValue(-1);
+    baseItem_->setTransformationMode(Qt::SmoothTransformation);
+    group_.circle->addToGroup(baseItem_);
+
     itemEventFilter_ = new ItemEventFilter(this);
     scene_->addItem(itemEventFilter_);
 
+    // Configurations are hoverable, an item is set up once for all its reuses
+    pool_.aspCfg = ItemPool(group_.aspCfg, [this](QGraphicsItem* item) {
+        item->setCursor(Qt::PointingHandCursor);
+        item->setAcceptHoverEvents(true);
+        item->installSceneEventFilter(itemEventFilter_);
+    });
+
     timer_ = new QTimer(this);
     timer_->setSingleShot(true);
 
@@ -39,8 +77,57 @@ Canvas::Canvas(const Kernel& kernel, QWidget* root)
 
 void Canvas::onRenderScene()
 {
+    // Within the aspect class only the resolution of the ring has changed
+    if (aspect_ == aspectClass())
+    {
+        if (trigger_.viewCircle)
+            renderMapBase();
+        return;
+    }
+
     updateCache();
+    renderLayers();
+}
+
+
+auto Canvas::renderScene(const QSize& size) -> void
+{
+    // The frame stands in for the viewport, the canvas is never shown
+    frame_ = size;
+
+    updateCache();
+    renderLayers();
+}
+
+
+auto Canvas::toPicture() -> QPicture
+{
+    QPicture picture;
+    picture.setBoundingRect(geo_);
 
+    QPainter painter (&picture);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(geo_, colorSrc_.textBkg);
+
+    // The ring is recorded from its own scene, vectors rather than the pixmap on screen
+    auto isBase (baseItem_->isVisible());
+    if (isBase)
+    {
+        baseScene_->render(&painter, geo_, geo_, Qt::IgnoreAspectRatio);
+        baseItem_->hide();
+    }
+
+    scene_->render(&painter, geo_, geo_, Qt::IgnoreAspectRatio);
+    baseItem_->setVisible(isBase);
+
+    painter.end();
+
+    return picture;
+}
+
+
+auto Canvas::renderLayers() -> void
+{
     if (trigger_.viewHeader)
         renderHeader();
     if (trigger_.viewRecepTree)
@@ -64,20 +151,26 @@ void Canvas::onRenderScene()
 
 void Canvas::updateCache(int cMask)
 {
-    auto geo (geometry());
-    auto isGeo (geo_ != geo);
+    RenderTrace::Scope scope (trace_, "updateCache");
+
+    auto aspect (aspectClass());
+    auto isGeo (aspect_ != aspect);
 
+    // The scene keeps its height in logical units, the view transform scales it
+    // to the window and only a new aspect class needs another layout
     if (isGeo)
     {
-        geo_ = geo;
-        scene_->setSceneRect(geo);
+        aspect_ = aspect;
+        geo_ = {0, 0, baseHeight_ * aspect / aspectSteps_, baseHeight_};
+        scene_->setSceneRect(geo_);
+        fitScene();
     }
 
     if (!isGeo && cMask <= 0)
         return;
 
-    auto width (geo.width());
-    auto height (geo.height());
+    auto width (geo_.width());
+    auto height (geo_.height());
 
     scale_ = height / 929.0;
     zeroPos_ = {0.5 * width + (scale_ * circleSizeSrc_.value("offset")), 0.5 * height};
@@ -93,10 +186,8 @@ void Canvas::updateCache(int cMask)
 
     //-----------------------------------------------------------------------//
 
-    auto item (new QGraphicsSimpleTextItem("Q"));
-    item->setFont(font_.canvasSym);
-
-    auto sh (0.23 * item->boundingRect().height());
+    auto symRect (metrics_.rect(font_.canvasSym, "Q"));
+    auto sh (0.23 * symRect.height());
 
     if (isGeo || (cMask & CanvasMask::PenCache) != 0)
     {
@@ -112,12 +203,11 @@ void Canvas::updateCache(int cMask)
         recepSize_ = {height, scale_, 4.35 * sh, recepSizeSrc_};
 
     if (isGeo || (cMask & CanvasMask::AspCfg) != 0)
-        aspCfgSize_ = {scale_, item->boundingRect().width(), 5 * sh, aspCfgSizeSrc_};
+        aspCfgSize_ = {scale_, symRect.width(), 5 * sh, aspCfgSizeSrc_};
 
     //-----------------------------------------------------------------------//
 
-    item->setFont(font_.canvasTxt);
-    sh = item->boundingRect().height();
+    sh = metrics_.rect(font_.canvasTxt, "Q").height();
 
     if (isGeo || (cMask & CanvasMask::Header) != 0)
         headerSize_ = {scale_, sh, headerSizeSrc_};
@@ -127,11 +217,8 @@ void Canvas::updateCache(int cMask)
 
     //-----------------------------------------------------------------------//
 
-    item->setText("Q*   10; 50' 24\" j");
-    item->setFont(font_.canvasSym);
-
     if (isGeo || (cMask & CanvasMask::CrdTable) != 0)
-        crdTableSize_ = {width, scale_, item->boundingRect(), crdTableSizeSrc_};
+        crdTableSize_ = {width, scale_, metrics_.rect(font_.canvasSym, "Q*   10; 50' 24\" j"), crdTableSizeSrc_};
 
     if (isGeo || (cMask & CanvasMask::LineBar) != 0)
         lineBarSize_ = {scale_, crdTableSize_, lineBarSizeSrc_};
@@ -146,6 +233,9 @@ void Canvas::updateCache(int cMask)
     if (isGeo || (cMask & CanvasMask::CoreStat) != 0)
         coreStatSize_ = {width, height, scale_, sh, coreStatSizeSrc_};
 
+    if (isGeo || (cMask & (CanvasMask::AspStat | CanvasMask::CoreStat | CanvasMask::FontCache)) != 0)
+        makeSymbols(sh);
+
     //-----------------------------------------------------------------------//
 
     if (isGeo || (cMask & CanvasMask::Circle) != 0)
@@ -164,46 +254,107 @@ void Canvas::onChangeBkg()
 }
 
 
+void Canvas::onShowTrace(bool mode)
+{
+    isTrace_ = mode;
+
+    // The overlay is redrawn with every change of the scene, not only where it changed
+    setViewportUpdateMode(mode ? FullViewportUpdate : MinimalViewportUpdate);
+    viewport()->update();
+}
+
+
 auto Canvas::resizeEvent(QResizeEvent* event) -> void
 {
-    timer_->start(50);
     QGraphicsView::resizeEvent(event);
+    fitScene();
+    timer_->start(50);
+
     emit sizeChanged(QString("%1x%2").arg(width()).arg(height()));
 }
 
 
+auto Canvas::drawForeground(QPainter* painter, const QRectF& rect) -> void
+{
+    Q_UNUSED(rect)
+
+    if (!isTrace_)
+        return;
+
+    auto text (trace_.toStrStat());
+
+    QFont font ("Consolas", 9);
+    font.setStyleHint(QFont::Monospace);
+
+    // In window coordinates, the overlay keeps its size whatever the scale
+    painter->save();
+    painter->resetTransform();
+    painter->setFont(font);
+
+    auto box (painter->boundingRect(QRectF(viewport()->rect()), Qt::AlignLeft | Qt::AlignTop, text));
+    box.moveTopRight(QPointF(viewport()->width() - 8, 8));
+
+    painter->fillRect(box.adjusted(-4, -4, 4, 4), QColor(255, 255, 255, 224));
+    painter->setPen(Qt::black);
+    painter->drawText(box, Qt::AlignLeft | Qt::AlignTop, text);
+    painter->restore();
+}
+
+
+auto Canvas::aspectClass() const -> int
+{
+    auto size (frame_.isValid() ? frame_ : viewport()->size());
+
+    // Width to height in steps, rounded down so the layout never outgrows the window
+    return std::max(aspectSteps_, aspectSteps_ * size.width() / std::max(size.height(), 1));
+}
+
+
+auto Canvas::fitScene() -> void
+{
+    if (geo_.isEmpty())
+        return;
+
+    QSizeF size (viewport()->size());
+    auto k (std::min(size.width() / geo_.width(), size.height() / geo_.height()));
+
+    setTransform(QTransform::fromScale(k, k));
+}
+
+
 auto Canvas::renderHeader(bool mode) -> void
 {
-    cleanGroup(group_.header);
+    auto& pool (pool_.header);
+    RenderTrace::Scope scope (trace_, "renderHeader", "canvas", &pool);
 
     if (!mode)
+    {
+        pool.clear();
         return;
+    }
 
     auto& moonDay (kernel_.getMoonDay());
+    auto& headerStr (kernel_.getHeaderStr());
 
-    auto dataItem (new QGraphicsSimpleTextItem(kernel_.getHeaderStr()));
-    dataItem->setFont(font_.canvasTxt);
-    dataItem->setBrush(colorSrc_.textFg);
-    dataItem->setPos(headerSize_.begPos);
-    group_.header->addToGroup(dataItem);
-
-    auto extItem (new QGraphicsSimpleTextItem(moonDay[0]));
-    extItem->setFont(font_.canvasTxt);
-    extItem->setBrush(colorSrc_.textFg);
-    extItem->setPos(headerSize_.extPos);
-    extItem->setToolTip(moonDay[1]);
-    group_.header->addToGroup(extItem);
+    pool.reset();
+    pool.text(headerStr, font_.canvasTxt, colorSrc_.textFg)->setPos(headerSize_.begPos);
+    pool.text(moonDay[0], font_.canvasTxt, colorSrc_.textFg, moonDay[1])->setPos(headerSize_.extPos);
+    pool.flush();
 
-    cmap_.header = {headerSize_.begPos, dataItem->boundingRect().size()};
+    cmap_.header = {headerSize_.begPos, metrics_.rect(font_.canvasTxt, headerStr).size()};
 }
 
 
 auto Canvas::renderRecepTree(bool mode) -> void
 {
-    cleanGroup(group_.recepTree);
+    auto& pool (pool_.recepTree);
+    RenderTrace::Scope scope (trace_, "renderRecepTree", "canvas", &pool);
 
     if (!mode)
+    {
+        pool.clear();
         return;
+    }
 
     auto& recepTree (kernel_.getRecepTree());
     auto& planetCatalog (kernel_.getPlanetCatalog());
@@ -222,6 +373,8 @@ auto Canvas::renderRecepTree(bool mode) -> void
     QString buffer;
     QString symbol ("=÷+-×");
 
+    pool.reset();
+
     for (auto& branch : recepTree)
     {
         for (auto& i : branch)
@@ -229,11 +382,7 @@ auto Canvas::renderRecepTree(bool mode) -> void
             if (count == recepSize_.maxLen)
             {
                 buffer.remove(buffer.size() - 2, 2);
-                auto recepItem (new QGraphicsSimpleTextItem(buffer));
-                recepItem->setFont(font_.canvasSym);
-                recepItem->setBrush(colorSrc_.textFg);
-                recepItem->setPos(strPos);
-                group_.recepTree->addToGroup(recepItem);
+                pool.text(buffer, font_.canvasSym, colorSrc_.textFg)->setPos(strPos);
 
                 count = 0;
                 strPos.ry() += recepSize_.offset;
@@ -252,21 +401,23 @@ auto Canvas::renderRecepTree(bool mode) -> void
     if (!buffer.isEmpty())
     {
         buffer.remove(buffer.size() - 2, 2);
-        auto recepItem (new QGraphicsSimpleTextItem(buffer));
-        recepItem->setFont(font_.canvasSym);
-        recepItem->setBrush(colorSrc_.textFg);
-        recepItem->setPos(strPos);
-        group_.recepTree->addToGroup(recepItem);
+        pool.text(buffer, font_.canvasSym, colorSrc_.textFg)->setPos(strPos);
     }
+
+    pool.flush();
 }
 
 
 auto Canvas::renderEsseStat(bool mode) -> void
 {
-    cleanGroup(group_.esseStat);
+    auto& pool (pool_.esseStat);
+    RenderTrace::Scope scope (trace_, "renderEsseStat", "canvas", &pool);
 
     if (!mode)
+    {
+        pool.clear();
         return;
+    }
 
     auto& planetCatalog (kernel_.getPlanetCatalog());
     auto& aspTabSpec (kernel_.getAspTabSpec());
@@ -319,6 +470,8 @@ auto Canvas::renderEsseStat(bool mode) -> void
     auto descPos (esseStatSize_.descPos);
     auto botRight (esseStatSize_.descPos);
 
+    pool.reset();
+
     for (auto i (14); i >= 0; --i)
     {
         descPos.ry() -= esseStatSize_.offset;
@@ -332,41 +485,39 @@ auto Canvas::renderEsseStat(bool mode) -> void
             continue;
         }
 
-        auto descItem (new QGraphicsSimpleTextItem(desc[i] + " "));
-        descItem->setFont(font_.canvasTxt);
-        descItem->setBrush(colorSrc_.textFg);
-        descItem->setPos(descPos);
-        group_.esseStat->addToGroup(descItem);
+        auto descStr (desc[i] + " ");
+        pool.text(descStr, font_.canvasTxt, colorSrc_.textFg)->setPos(descPos);
 
         QString buffer;
         for (auto j : *data[i])
             buffer += planetCatalog.at(j);
 
-        auto dataPos (descPos + descItem->boundingRect().topRight());
+        auto dataPos (descPos + metrics_.rect(font_.canvasTxt, descStr).topRight());
         dataPos.ry() += esseStatSize_.crutch;
 
-        auto dataItem (new QGraphicsSimpleTextItem(buffer));
-        dataItem->setFont(font_.canvasSym);
-        dataItem->setBrush(colorSrc_.textFg);
-        dataItem->setPos(dataPos);
-        group_.esseStat->addToGroup(dataItem);
+        pool.text(buffer, font_.canvasSym, colorSrc_.textFg)->setPos(dataPos);
 
-        auto right (dataPos.x() + dataItem->boundingRect().width());
+        auto right (dataPos.x() + metrics_.rect(font_.canvasSym, buffer).width());
         if (right > botRight.x())
             botRight.rx() = right;
     }
 
+    pool.flush();
+
     cmap_.esseStat = {descPos, botRight};
 }
 
 
 auto Canvas::renderCircle(bool mode) -> void
 {
-    cleanGroup(group_.circle);
+    RenderTrace::Scope scope (trace_, "renderCircle", "canvas", &pool_.circle);
 
     if (!mode)
     {
-        cleanGroup(group_.aspects);
+        baseItem_->hide();
+        pool_.circle.clear();
+        pool_.aspects.clear();
+        dropMarkers();
         return;
     }
 
@@ -375,22 +526,47 @@ auto Canvas::renderCircle(bool mode) -> void
 
     renderMapBase();
 
+    pool_.circle.reset();
+
     if (trigger_.circleCuspids)
         renderCuspids();
 
     renderPlanets();
+
+    pool_.circle.flush();
+
     renderAspects();
 }
 
 
 auto Canvas::renderMapBase() -> void
 {
+    RenderTrace::Scope scope (trace_, "renderMapBase", "canvas", &basePool_);
+
     const auto& [outRect, signRect, capRect, insRect, symRad] (mapBaseSize_);
 
-    auto circleItem (new QGraphicsEllipseItem(outRect));
-    circleItem->setPen(pen_.borderFg);
-    circleItem->setBrush(colorSrc_.circleBkg);
-    group_.circle->addToGroup(circleItem);
+    auto stamp (qHashMulti(0, zeroAng_, zeroPos_.x(), zeroPos_.y(), outRect.width(), symRad, font_.signSym,
+                           pen_.borderFg.color().rgba(), pen_.borderFg.widthF(), colorSrc_.signSymFg.color().rgba(),
+                           colorSrc_.circleBkg.color().rgba(), colorSrc_.aspFieldBkg.color().rgba()));
+    for (auto& i : colorSrc_.signBkg)
+        stamp = qHashMulti(stamp, i.color().rgba());
+
+    auto scale (transform().m11() * devicePixelRatioF());
+
+    baseItem_->show();
+
+    // Time steps leave the ring alone unless it turns with the ascendant
+    if (stamp == baseStamp_)
+    {
+        if (scale != baseScale_)
+            paintMapBase(scale);
+        return;
+    }
+
+    auto& pool (basePool_);
+
+    pool.reset();
+    pool.ellipse(pen_.borderFg, colorSrc_.circleBkg)->setRect(outRect);
 
     for (auto i (0), j (0); i < 12; ++i, ++j)
     {
@@ -400,29 +576,47 @@ auto Canvas::renderMapBase() -> void
         auto ang (zeroAng_ - 30 * i);
         auto pos (zeroPos_ + symRad * QPointF(cosDeg(ang - 15), -sinDeg(ang - 15)));
 
-        auto signItem (new QGraphicsEllipseItem(signRect));
-        signItem->setPen(pen_.borderFg);
-        signItem->setBrush(colorSrc_.signBkg[j]);
-        signItem->setStartAngle(16 * ang);
-        signItem->setSpanAngle(-480);
-        group_.circle->addToGroup(signItem);
-
-        auto symItem (new QGraphicsSimpleTextItem(RefBook::signSym[i]));
-        symItem->setFont(font_.signSym);
-        symItem->setBrush(colorSrc_.signSymFg);
-        symItem->setPos(pos - symItem->boundingRect().center());
-        group_.circle->addToGroup(symItem);
+        pool.ellipse(pen_.borderFg, colorSrc_.signBkg[j], 16 * ang, -480)->setRect(signRect);
+
+        pool.text(RefBook::signSym[i], font_.signSym, colorSrc_.signSymFg)->setPos(
+            pos - metrics_.rect(font_.signSym, RefBook::signSym[i]).center());
     }
 
-    circleItem = new QGraphicsEllipseItem(capRect);
-    circleItem->setPen(pen_.borderFg);
-    circleItem->setBrush(colorSrc_.circleBkg);
-    group_.circle->addToGroup(circleItem);
+    pool.ellipse(pen_.borderFg, colorSrc_.circleBkg)->setRect(capRect);
+    pool.ellipse(pen_.borderFg, colorSrc_.aspFieldBkg)->setRect(insRect);
+    pool.flush();
 
-    circleItem = new QGraphicsEllipseItem(insRect);
-    circleItem->setPen(pen_.borderFg);
-    circleItem->setBrush(colorSrc_.aspFieldBkg);
-    group_.circle->addToGroup(circleItem);
+    baseStamp_ = stamp;
+    paintMapBase(scale);
+}
+
+
+auto Canvas::paintMapBase(double scale) -> void
+{
+    RenderTrace::Scope scope (trace_, "paintMapBase");
+
+    auto ratio (devicePixelRatioF());
+    auto margin (pen_.borderFg.widthF());
+    auto source (mapBaseSize_.outRect.adjusted(-margin, -margin, margin, margin));
+
+    // One pixmap pixel for each device pixel the ring covers at the current transform
+    QPixmap pixmap ((scale * source.size()).toSize());
+    if (pixmap.isNull())
+        return;
+
+    pixmap.setDevicePixelRatio(ratio);
+    pixmap.fill(Qt::transparent);
+
+    QPainter painter (&pixmap);
+    painter.setRenderHint(QPainter::Antialiasing);
+    baseScene_->render(&painter, QRectF(QPointF(), QSizeF(pixmap.size()) / ratio), source, Qt::IgnoreAspectRatio);
+    painter.end();
+
+    baseItem_->setPixmap(pixmap);
+    baseItem_->setPos(source.topLeft());
+    baseItem_->setScale(ratio / scale);
+
+    baseScale_ = scale;
 }
 
 
@@ -435,6 +629,8 @@ auto Canvas::renderCuspids() -> void
     auto cuspidLineFg (QPen(colorSrc_.cuspLineFg));
     auto [endR2, endR1, begR2, begR1, tipAng, arrAdd, arrLen, bedLen] (cuspidSize_);
 
+    auto& pool (pool_.circle);
+
     for (auto i (0); i < 12; ++i)
     {
         auto ang (360 + zeroAng_ - cuspidCrd[i]);
@@ -444,8 +640,8 @@ auto Canvas::renderCuspids() -> void
         auto shift (QPointF(cosDeg(ang), -sinDeg(ang)));
         auto endP2 (zeroPos_ + endR2 * shift);
 
-        auto begItem (new QGraphicsLineItem({zeroPos_ + begR1 * shift, zeroPos_ + begR2 * shift}));
-        auto endItem (new QGraphicsLineItem({zeroPos_ + endR1 * shift, endP2}));
+        QLineF begLine (zeroPos_ + begR1 * shift, zeroPos_ + begR2 * shift);
+        QLineF endLine (zeroPos_ + endR1 * shift, endP2);
 
         switch (i) {
         case 0 :
@@ -457,12 +653,9 @@ auto Canvas::renderCuspids() -> void
             auto angL (ang - 180 - tipAng);
             auto angR (ang + 180 + tipAng);
 
-            auto arrItem (new QGraphicsPolygonItem({
+            pool.polygon(cuspidLineFg, cuspidLineFg.brush())->setPolygon({
                 endP3, endP3 + arrLen * QPointF(cosDeg(angL), -sinDeg(angL)),
-                endP2, endP3 + arrLen * QPointF(cosDeg(angR), -sinDeg(angR))}));
-            arrItem->setPen(cuspidLineFg);
-            arrItem->setBrush(cuspidLineFg.brush());
-            group_.circle->addToGroup(arrItem);
+                endP2, endP3 + arrLen * QPointF(cosDeg(angR), -sinDeg(angR))});
         }
             break;
         case 3 :
@@ -473,43 +666,30 @@ auto Canvas::renderCuspids() -> void
             auto angL (ang + 60 + tipAng);
             auto angR (ang - 60 - tipAng);
 
-            auto bedItem (new QGraphicsLineItem(
-                {endP2, endP2 + bedLen * QPointF(cosDeg(angL), -sinDeg(angL))}));
-            bedItem->setPen(cuspidLineFg);
-            group_.circle->addToGroup(bedItem);
-
-            bedItem = new QGraphicsLineItem(
+            pool.line(cuspidLineFg)->setLine(
+                {endP2, endP2 + bedLen * QPointF(cosDeg(angL), -sinDeg(angL))});
+            pool.line(cuspidLineFg)->setLine(
                 {endP2, endP2 + bedLen * QPointF(cosDeg(angR), -sinDeg(angR))});
-            bedItem->setPen(cuspidLineFg);
-            group_.circle->addToGroup(bedItem);
         }
             break;
         default :
             cuspidLineFg.setWidthF(scale_);
         }
 
-        begItem->setPen(cuspidLineFg);
-        endItem->setPen(cuspidLineFg);
-        group_.circle->addToGroup(begItem);
-        group_.circle->addToGroup(endItem);
+        pool.line(cuspidLineFg)->setLine(begLine);
+        pool.line(cuspidLineFg)->setLine(endLine);
 
-        auto symItem (new QGraphicsSimpleTextItem(RefBook::cuspidSym[i]));
-        symItem->setFont(font_.cuspidSym);
-        symItem->setBrush(colorSrc_.cuspSymFg);
-        symItem->setToolTip(cuspidCrdStr[i][1]);
+        auto symItem (pool.text(RefBook::cuspidSym[i], font_.cuspidSym, colorSrc_.cuspSymFg, cuspidCrdStr[i][1]));
 
-        auto symRect (symItem->boundingRect());
+        auto symRect (metrics_.rect(font_.cuspidSym, RefBook::cuspidSym[i]));
         auto symAng (ang + 180 + (ang > 179.99 && ang < 359.99 ? -90 : 90));
         auto symPos (endP2 + symRect.height() * QPointF(cosDeg(symAng), -sinDeg(symAng)) - symRect.center());
 
         symItem->setPos(symPos);
-        group_.circle->addToGroup(symItem);
 
         if (trigger_.circleDegrees)
         {
-            auto supItem (new QGraphicsSimpleTextItem(QString("%1").arg(cuspidDegree[i])));
-            supItem->setFont(font_.cuspidSymSup);
-            supItem->setBrush(colorSrc_.cuspSymFg);
+            auto supItem (pool.text(QString("%1").arg(cuspidDegree[i]), font_.cuspidSymSup, colorSrc_.cuspSymFg));
 
             switch (i) { // font crutch
             case 3 :
@@ -523,7 +703,6 @@ auto Canvas::renderCuspids() -> void
             }
 
             supItem->setPos(symPos + symRect.topRight());
-            group_.circle->addToGroup(supItem);
         }
     }
 }
@@ -542,6 +721,8 @@ auto Canvas::renderPlanets() -> void
     auto brush (colorSrc_.planetSymFg);
     auto [insRad, symRad, markRect] (planetSize_);
 
+    auto& pool (pool_.circle);
+
     for (auto i : kernel_.getPlanetOrder())
     {
         auto insAng (360 + zeroAng_ - planetCrd.at(i));
@@ -559,25 +740,15 @@ auto Canvas::renderPlanets() -> void
         markLine.setLength(0.5 * markLine.length());
         markRect.moveCenter(insPos);
 
-        auto mark1Item (new QGraphicsLineItem(markLine));
-        mark1Item->setPen(pen_.planetLineFg);
-        group_.circle->addToGroup(mark1Item);
-
-        auto mark2Item (new QGraphicsEllipseItem(markRect));
-        mark2Item->setPen(pen_.borderFg);
-        mark2Item->setBrush(colorSrc_.aspFieldBkg);
-        group_.circle->addToGroup(mark2Item);
+        pool.line(pen_.planetLineFg)->setLine(markLine);
+        pool.ellipse(pen_.borderFg, colorSrc_.aspFieldBkg)->setRect(markRect);
 
         if (trigger_.circleColors)
             brush = colorSrc_.getSpec({i, planetSignNo.at(i)});
 
-        auto symItem (new QGraphicsSimpleTextItem(planetCatalog.at(i)));
-        symItem->setFont(font_.planetSym);
-        symItem->setBrush(brush);
-        symItem->setToolTip(planetCrdStr.at(i)[1]);
-        auto symRect (symItem->boundingRect());
-        symItem->setPos(symPos -= symRect.center());
-        group_.circle->addToGroup(symItem);
+        auto& symStr (planetCatalog.at(i));
+        auto  symRect (metrics_.rect(font_.planetSym, symStr));
+        pool.text(symStr, font_.planetSym, brush, planetCrdStr.at(i)[1])->setPos(symPos -= symRect.center());
 
         symPos += symRect.topRight();
 
@@ -599,40 +770,95 @@ auto Canvas::renderPlanets() -> void
         {
             auto degree (planetDegree.at(i));
 
-            auto supItem (new QGraphicsSimpleTextItem(QString("%1").arg(degree)));
-            supItem->setFont(font_.planetSymSup);
-            supItem->setBrush(brush);
-            supItem->setPos(symPos + crutch);
-            group_.circle->addToGroup(supItem);
+            auto supStr (QString("%1").arg(degree));
+            pool.text(supStr, font_.planetSymSup, brush)->setPos(symPos + crutch);
 
             if (degree > 9)
-                crutch.rx() += 0.25 * supItem->boundingRect().width();
+                crutch.rx() += 0.25 * metrics_.rect(font_.planetSymSup, supStr).width();
         }
         else if (i == 5)
             crutch.rx() += scale_;
 
         if (trigger_.circleSpeeds)
         {
-            auto subItem (new QGraphicsSimpleTextItem(planetSpeedSym.at(i)));
-            subItem->setFont(font_.planetSymSub);
-            subItem->setBrush(brush);
-            symPos.ry() += symRect.height() - 1.15 * subItem->boundingRect().height();
-            subItem->setPos(symPos + crutch);
-            group_.circle->addToGroup(subItem);
+            auto& subStr (planetSpeedSym.at(i));
+            symPos.ry() += symRect.height() - 1.15 * metrics_.rect(font_.planetSymSub, subStr).height();
+            pool.text(subStr, font_.planetSymSub, brush)->setPos(symPos + crutch);
         }
     }
 }
 
 
-auto Canvas::renderAspects(QGraphicsItem* item) -> void
+auto Canvas::renderAspects() -> void
 {
     if (!trigger_.viewCircle)
         return;
 
-    auto isNormal (item == nullptr);
-    auto group (isNormal ? group_.aspects : group_.markers);
+    RenderTrace::Scope scope (trace_, "renderAspects", "canvas", &pool_.aspects);
+
+    drawAspects(pool_.aspects);
+    dropMarkers();
+}
+
+
+auto Canvas::renderMarkers(QGraphicsItem* item) -> void
+{
+    auto shown (marker_.find(marked_));
+    if (shown != marker_.end())
+        shown->second.group->hide();
+
+    marked_ = item;
+
+    if (item == nullptr || !trigger_.viewCircle)
+        return;
+
+    auto iter (marker_.find(item));
+    if (iter == marker_.end())
+    {
+        auto group (new QGraphicsItemGroup);
+        group_.markers->addToGroup(group);
+        iter = marker_.emplace(item, MarkerCache {group, ItemPool(group), false}).first;
+    }
+
+    // Built on the first hover of a chart, later hovers only show the group
+    auto& [group, pool, isValid] (iter->second);
+    if (!isValid)
+    {
+        RenderTrace::Scope scope (trace_, "renderMarkers", "canvas", &pool);
+        drawAspects(pool, item);
+        isValid = true;
+    }
 
-    cleanGroup(group);
+    group->show();
+}
+
+
+auto Canvas::dropMarkers() -> void
+{
+    auto child (group_.aspCfg->childItems());
+
+    for (auto i (marker_.begin()); i != marker_.end();)
+    {
+        // Items the configuration pool has let go of take their markers along
+        if (!child.contains(i->first))
+        {
+            delete i->second.group;
+            i = marker_.erase(i);
+            continue;
+        }
+
+        i->second.group->hide();
+        i->second.isValid = false;
+        ++i;
+    }
+
+    marked_ = nullptr;
+}
+
+
+auto Canvas::drawAspects(ItemPool& pool, QGraphicsItem* item) -> void
+{
+    auto isNormal (item == nullptr);
 
     auto& planetCrd (kernel_.getPlanetCrd());
     auto& aspCatalog (kernel_.getAspCatalog());
@@ -645,6 +871,8 @@ auto Canvas::renderAspects(QGraphicsItem* item) -> void
     auto widthA (isNormal ? scale_ : 3 * scale_);
     auto [insRad, widthB, unionRect] (aspectSize_);
 
+    pool.reset();
+
     for (auto key : aspGroup)
         for (auto& i : aspSample[key])
         {
@@ -682,18 +910,10 @@ auto Canvas::renderAspects(QGraphicsItem* item) -> void
             if (line.length() <= unionRect.width())
             {
                 unionRect.moveCenter(line.pointAt(0.5));
-
-                auto aspItem (new QGraphicsEllipseItem(unionRect));
-                aspItem->setPen(pen);
-                aspItem->setBrush(pen.brush());
-                group->addToGroup(aspItem);
+                pool.ellipse(pen, pen.brush())->setRect(unionRect);
             }
             else
-            {
-                auto aspItem (new QGraphicsLineItem(line));
-                aspItem->setPen(pen);
-                group->addToGroup(aspItem);
-            }
+                pool.line(pen)->setLine(line);
 
             if (asp != 0 && asp != 180)
             {
@@ -701,11 +921,7 @@ auto Canvas::renderAspects(QGraphicsItem* item) -> void
                 auto fontId (aspType.at(asp));
                 auto aspStr (aspCatalog.at(asp));
 
-                auto symItem (new QGraphicsSimpleTextItem(aspStr));
-                symItem->setFont(font_[fontId]);
-                symItem->setBrush(pen.brush());
-
-                auto rect (symItem->boundingRect());
+                auto rect (metrics_.rect(font_[fontId], aspStr));
 
                 if (fontId == 0)
                     rect.setSize(1.1 * rect.size());
@@ -716,26 +932,28 @@ auto Canvas::renderAspects(QGraphicsItem* item) -> void
                         rect.setY(rect.y() - scale_);
                 }
 
-                symItem->setPos(center - rect.center());
+                auto symPos (center - rect.center());
                 rect.moveCenter(center);
 
-                auto cleanItem (new QGraphicsEllipseItem(rect));
-                cleanItem->setPen(Qt::NoPen);
-                cleanItem->setBrush(colorSrc_.aspFieldBkg);
-
-                group->addToGroup(cleanItem);
-                group->addToGroup(symItem);
+                pool.ellipse(Qt::NoPen, colorSrc_.aspFieldBkg)->setRect(rect);
+                pool.text(aspStr, font_[fontId], pen.brush())->setPos(symPos);
             }
         }
+
+    pool.flush();
 }
 
 
 auto Canvas::renderCrdTable(bool mode) -> void
 {
-    cleanGroup(group_.crdTable);
+    auto& pool (pool_.crdTable);
+    RenderTrace::Scope scope (trace_, "renderCrdTable", "canvas", &pool);
 
     if (!mode)
+    {
+        pool.clear();
         return;
+    }
 
     auto& planetCatalog (kernel_.getPlanetCatalog());
     auto& planetCrd (kernel_.getPlanetCrd());
@@ -750,44 +968,24 @@ auto Canvas::renderCrdTable(bool mode) -> void
     const auto& baseFg (colorSrc_.spec[SpecState::Neutral]);
     auto [step, symX, crdX, kadX, starX, posY, maxX] (crdTableSize_);
 
+    pool.reset();
+
     for (auto i : kernel_.getPlanetOrder())
     {
         auto& strFg (colorSrc_.getSpec({i, planetSignNo.at(i)}));
 
-        auto symItem (new QGraphicsSimpleTextItem(planetCatalog.at(i) + planetSpeedSym.at(i)));
-        symItem->setFont(font_.canvasSym);
-        symItem->setBrush(strFg);
-        symItem->setPos(symX, posY);
-        group_.crdTable->addToGroup(symItem);
-
-        auto crdItem (new QGraphicsSimpleTextItem(planetCrdStr.at(i)[0]));
-        crdItem->setFont(font_.canvasSym);
-        crdItem->setBrush(strFg);
-        crdItem->setPos(crdX, posY);
-        group_.crdTable->addToGroup(crdItem);
+        pool.text(planetCatalog.at(i) + planetSpeedSym.at(i), font_.canvasSym, strFg)->setPos(symX, posY);
+        pool.text(planetCrdStr.at(i)[0], font_.canvasSym, strFg)->setPos(crdX, posY);
 
         auto kad (getKadData(planetCrd.at(i)));
         if (kad.second != nullptr)
-        {
-            auto kadItem (new QGraphicsSimpleTextItem(kad.first));
-            kadItem->setFont(font_.canvasSym);
-            kadItem->setBrush(*kad.second);
-            kadItem->setPos(kadX, posY);
-            group_.crdTable->addToGroup(kadItem);
-        }
+            pool.text(kad.first, font_.canvasSym, *kad.second)->setPos(kadX, posY);
 
         if (trigger_.fixedStars)
         {
             auto& cell (planetStarTable.at(i));
             if (!cell[0].isEmpty())
-            {
-                auto starItem (new QGraphicsSimpleTextItem(cell[0]));
-                starItem->setFont(font_.fixedStar);
-                starItem->setBrush(baseFg);
-                starItem->setToolTip(cell[1]);
-                starItem->setPos(starX, posY);
-                group_.crdTable->addToGroup(starItem);
-            }
+                pool.text(cell[0], font_.fixedStar, baseFg, cell[1])->setPos(starX, posY);
         }
 
         posY += step;
@@ -797,9 +995,8 @@ auto Canvas::renderCrdTable(bool mode) -> void
 
     for (auto i (0); i < 12; ++i)
     {
-        auto symItem (new QGraphicsSimpleTextItem(RefBook::cuspidSym[i]));
-        symItem->setFont(font_.canvasSym);
-        symItem->setBrush(baseFg);
+        auto symItem (pool.text(RefBook::cuspidSym[i], font_.canvasSym, baseFg));
+        auto symWidth (metrics_.rect(font_.canvasSym, RefBook::cuspidSym[i]).width());
 
         auto crutch (0.0);
         switch (i) {
@@ -809,51 +1006,35 @@ auto Canvas::renderCrdTable(bool mode) -> void
         case 9 :
             break;
         case 10 :
-            crutch = -0.14 * symItem->boundingRect().width();
+            crutch = -0.14 * symWidth;
             break;
         case 11 :
-            crutch = -0.15 * symItem->boundingRect().width();
+            crutch = -0.15 * symWidth;
             break;
         default :
-            crutch = 0.23 * symItem->boundingRect().width();
+            crutch = 0.23 * symWidth;
         }
 
         symItem->setPos(symX + crutch, posY);
-        group_.crdTable->addToGroup(symItem);
 
-        auto crdItem (new QGraphicsSimpleTextItem(cuspidCrdStr[i][0]));
-        crdItem->setFont(font_.canvasSym);
-        crdItem->setBrush(baseFg);
-        crdItem->setPos(crdX, posY);
-        group_.crdTable->addToGroup(crdItem);
+        pool.text(cuspidCrdStr[i][0], font_.canvasSym, baseFg)->setPos(crdX, posY);
 
         auto kad (getKadData(cuspidCrd[i]));
         if (kad.second != nullptr)
-        {
-            auto kadItem (new QGraphicsSimpleTextItem(kad.first));
-            kadItem->setFont(font_.canvasSym);
-            kadItem->setBrush(*kad.second);
-            kadItem->setPos(kadX, posY);
-            group_.crdTable->addToGroup(kadItem);
-        }
+            pool.text(kad.first, font_.canvasSym, *kad.second)->setPos(kadX, posY);
 
         if (trigger_.fixedStars)
         {
             auto& cell (cuspidStarTable[i]);
             if (!cell[0].isEmpty())
-            {
-                auto starItem (new QGraphicsSimpleTextItem(cell[0]));
-                starItem->setFont(font_.fixedStar);
-                starItem->setBrush(baseFg);
-                starItem->setToolTip(cell[1]);
-                starItem->setPos(starX, posY);
-                group_.crdTable->addToGroup(starItem);
-            }
+                pool.text(cell[0], font_.fixedStar, baseFg, cell[1])->setPos(starX, posY);
         }
 
         posY += step;
     }
 
+    pool.flush();
+
     cmap_.crdTable = {
         QPointF(crdTableSize_.symX, crdTableSize_.posY),
         QPointF(trigger_.fixedStars ? maxX : starX, posY)};
@@ -862,10 +1043,14 @@ auto Canvas::renderCrdTable(bool mode) -> void
 
 auto Canvas::renderLineBar(bool mode) -> void
 {
-    cleanGroup(group_.lineBar);
+    auto& pool (pool_.lineBar);
+    RenderTrace::Scope scope (trace_, "renderLineBar", "canvas", &pool);
 
     if (!mode)
+    {
+        pool.clear();
         return;
+    }
 
     auto& planetStat (kernel_.getPlanetStat());
 
@@ -889,7 +1074,10 @@ auto Canvas::renderLineBar(bool mode) -> void
     else
         scale = lineBarSize_.cosmicScale;
 
-    auto dItem (new QGraphicsLineItem);
+    QLineF lastLine;
+
+    pool.reset();
+
     for (auto i : kernel_.getPlanetOrder())
     {
         auto stat (planetStat.find(i));
@@ -903,16 +1091,15 @@ auto Canvas::renderLineBar(bool mode) -> void
         uLine.setLength(scale * std::abs(stat->second[0]) + 1e-3);
         dLine.setLength(scale * std::abs(stat->second[1]) + 1e-3);
 
-        auto uItem (new QGraphicsLineItem(uLine));
-        dItem = new QGraphicsLineItem(dLine);
-
-        uItem->setPen(stat->second[0] > 0 ? *pen[0] : *pen[1]);
-        dItem->setPen(stat->second[1] > 0 ? *pen[2] : *pen[3]);
+        auto& uPen (stat->second[0] > 0 ? *pen[0] : *pen[1]);
+        auto& dPen (stat->second[1] > 0 ? *pen[2] : *pen[3]);
 
         if (stat->second[0] != 0)
-            group_.lineBar->addToGroup(uItem);
+            pool.line(uPen)->setLine(uLine);
         if (stat->second[1] != 0)
-            group_.lineBar->addToGroup(dItem);
+            pool.line(dPen)->setLine(dLine);
+
+        lastLine = dLine;
 
         auto isPoint (false);
 
@@ -937,22 +1124,19 @@ auto Canvas::renderLineBar(bool mode) -> void
             point.moveCenter(
                 (stat->second[0] != 0 ? uLine.p2() : dLine.p2()) - 1.5 * point.topRight());
 
-            auto pointItem (new QGraphicsEllipseItem(point));
-            pointItem->setPen({Qt::NoPen});
-            pointItem->setBrush((stat->second[0] != 0 ? uItem : dItem)->pen().brush());
-            group_.lineBar->addToGroup(pointItem);
+            pool.ellipse(Qt::NoPen, (stat->second[0] != 0 ? uPen : dPen).brush())->setRect(point);
         }
 
         uLine.translate(lineBarSize_.offset);
         dLine.translate(lineBarSize_.offset);
     }
 
-    cmap_.lineBar = {lineBarSize_.topLeft, dItem->line().p1() + 0.49 * lineBarSize_.offset};
+    cmap_.lineBar = {lineBarSize_.topLeft, lastLine.p1() + 0.49 * lineBarSize_.offset};
 
     if (trigger_.modePrime || trigger_.modeCosmic)
     {
         auto kv (trigger_.modePrime ? 7 : 10);
-        auto p1 (dItem->line().p1());
+        auto p1 (lastLine.p1());
         auto p2 (lineBarSize_.uLine.p1());
         auto dy (0.5 * pen[0]->widthF());
 
@@ -961,41 +1145,38 @@ auto Canvas::renderLineBar(bool mode) -> void
         p1.ry() += dy;
         p2.ry() -= dy;
 
-        auto markLine (new QGraphicsLineItem({p1, p2}));
-        markLine->setPen(pen_.markLine);
-        group_.lineBar->addToGroup(markLine);
+        pool.line(pen_.markLine)->setLine({p1, p2});
 
-        auto markText (new QGraphicsSimpleTextItem(QString("%1").arg(kv)));
-        markText->setFont(font_.markLine);
-        markText->setBrush(pen_.markLine.brush());
-
-        auto rect (markText->boundingRect());
-        markText->setPos(p2 - rect.center() - 0.5 * rect.bottomLeft());
-        group_.lineBar->addToGroup(markText);
+        auto markStr (QString("%1").arg(kv));
+        auto rect (metrics_.rect(font_.markLine, markStr));
+        pool.text(markStr, font_.markLine, pen_.markLine.brush())->setPos(p2 - rect.center() - 0.5 * rect.bottomLeft());
 
         if (trigger_.modeCosmic)
         {
             auto sum (std::round(kernel_.getCosmicSum()));
             auto mask (tr("Total") + " %1%2");
 
-            auto sumItem (new QGraphicsSimpleTextItem(mask.arg(sum > 0 ? "+" : "").arg(sum)));
-            sumItem->setFont(font_.markLine);
-            sumItem->setBrush(pen_.markLine.brush());
-
-            auto rect (sumItem->boundingRect());
-            sumItem->setPos(p1 - rect.center() + rect.bottomLeft());
-            group_.lineBar->addToGroup(sumItem);
+            auto sumStr (mask.arg(sum > 0 ? "+" : "").arg(sum));
+            auto rect (metrics_.rect(font_.markLine, sumStr));
+            pool.text(sumStr, font_.markLine, pen_.markLine.brush())->setPos(p1 - rect.center() + rect.bottomLeft());
         }
     }
+
+    pool.flush();
 }
 
 
 auto Canvas::renderAspCfg(bool mode) -> void
 {
-    cleanGroup(group_.aspCfg);
+    auto& pool (pool_.aspCfg);
+    RenderTrace::Scope scope (trace_, "renderAspCfg", "canvas", &pool);
 
     if (!mode)
+    {
+        pool.clear();
+        dropMarkers();
         return;
+    }
 
     auto& planetCatalog (kernel_.getPlanetCatalog());
     auto& aspCfgBone (kernel_.getAspCfgBone());
@@ -1013,6 +1194,8 @@ auto Canvas::renderAspCfg(bool mode) -> void
     QPointF beg (1e7, basePos.y());
     QPointF end (0, 0);
 
+    pool.reset();
+
     for (auto& i : kernel_.getAspCfgTable())
         for (auto& cfg : i.second.first)
         {
@@ -1026,40 +1209,33 @@ auto Canvas::renderAspCfg(bool mode) -> void
 
             QVariantList list {cfg.begin(), cfg.end()};
 
-            auto descItem (new QGraphicsSimpleTextItem(i.second.second->title));
+            auto& title (i.second.second->title);
+            auto  descPos (basePos - metrics_.rect(font_.canvasTxt, title).topRight() - crutch);
+
+            auto descItem (pool.text(title, font_.canvasTxt, colorSrc_.textFg));
             descItem->setData(0, i.first);
             descItem->setData(1, list);
-            descItem->setFont(font_.canvasTxt);
-            descItem->setBrush(colorSrc_.textFg);
-            descItem->setCursor(Qt::PointingHandCursor);
-            descItem->setAcceptHoverEvents(true);
-            descItem->setPos(basePos - descItem->boundingRect().topRight() - crutch);
-            group_.aspCfg->addToGroup(descItem);
-
-            auto leftX (descItem->pos().x());
+            descItem->setPos(descPos);
+
+            auto leftX (descPos.x());
             if (leftX < beg.x())
                 beg.setX(leftX);
 
-            auto dataItem (new QGraphicsSimpleTextItem(str));
+            auto dataItem (pool.text(str, font_.canvasSym, colorSrc_.textFg));
             dataItem->setData(0, i.first);
             dataItem->setData(1, list);
-            dataItem->setFont(font_.canvasSym);
-            dataItem->setBrush(colorSrc_.textFg);
-            dataItem->setCursor(Qt::PointingHandCursor);
-            dataItem->setAcceptHoverEvents(true);
             dataItem->setPos(basePos);
-            group_.aspCfg->addToGroup(dataItem);
 
-            auto rightX (basePos.x() + dataItem->boundingRect().width());
+            auto rightX (basePos.x() + metrics_.rect(font_.canvasSym, str).width());
             if (rightX > end.x())
                 end.setX(rightX);
 
-            descItem->installSceneEventFilter(itemEventFilter_);
-            dataItem->installSceneEventFilter(itemEventFilter_);
-
             basePos += offset;
         }
 
+    pool.flush();
+    dropMarkers();
+
     basePos.setX(0);
     cmap_.aspCfg = {beg, end + basePos - 0.13 * offset};
 }
@@ -1067,10 +1243,14 @@ auto Canvas::renderAspCfg(bool mode) -> void
 
 auto Canvas::renderAspStat(bool mode) -> void
 {
-    cleanGroup(group_.aspStat);
+    auto& pool (pool_.aspStat);
+    RenderTrace::Scope scope (trace_, "renderAspStat", "canvas", &pool);
 
     if (!mode)
+    {
+        pool.clear();
         return;
+    }
 
     auto& aspField (kernel_.getAspField());
 
@@ -1078,6 +1258,10 @@ auto Canvas::renderAspStat(bool mode) -> void
     auto color (fg.color());
     auto base (aspStatSize_.base);
 
+    SymbolBatch batch;
+
+    pool.reset();
+
     for (auto i (0), j (21); i < 6; ++i, ++j)
     {
         if (i == 0 || i == 5)
@@ -1085,31 +1269,39 @@ auto Canvas::renderAspStat(bool mode) -> void
         else
             fg.setColor(colorSrc_.force[aspField[i].second]);
 
-        group_.aspStat->addToGroup(symbol(j, fg, base));
+        symbol(batch, j, fg.color(), base.topLeft());
 
         auto num (i == 5 ? aspField[0].second : std::round(aspField[i].first));
-        auto numItem (new QGraphicsSimpleTextItem(QString("%1").arg(num, 2)));
-        numItem->setFont(font_.canvasTxt);
-        numItem->setBrush(fg.brush());
+        auto numItem (pool.text(QString("%1").arg(num, 2), font_.canvasTxt, fg.brush()));
         numItem->setPos(base.bottomLeft() + aspStatSize_.offset);
-        group_.aspStat->addToGroup(numItem);
 
         base.moveLeft(base.left() + aspStatSize_.step);
     }
+
+    drawSymbols(pool, batch);
+    pool.flush();
 }
 
 
 auto Canvas::renderCoreStat(bool mode) -> void
 {
-    cleanGroup(group_.coreStat);
+    auto& pool (pool_.coreStat);
+    RenderTrace::Scope scope (trace_, "renderCoreStat", "canvas", &pool);
 
     if (!mode)
+    {
+        pool.clear();
         return;
+    }
 
     auto  fg (pen_.textFg);
     auto  inv (trigger_.coreStatInvert);
     auto& base (coreStatSize_.base);
 
+    SymbolBatch batch;
+
+    pool.reset();
+
     for (auto i (0); i < 2; ++i)
     {
         if (!*(&trigger_.coreStatCosEnb + i))
@@ -1124,11 +1316,7 @@ auto Canvas::renderCoreStat(bool mode) -> void
 
         coreStatSize_.resetBase(view, inv);
 
-        auto title (new QGraphicsSimpleTextItem(view ? tr("Cosmogram") : tr("Horoscope")));
-        title->setFont(font_.canvasTxt);
-        title->setBrush(colorSrc_.textFg);
-        title->setPos(base.topLeft());
-        group_.coreStat->addToGroup(title);
+        pool.text(view ? tr("Cosmogram") : tr("Horoscope"), font_.canvasTxt, colorSrc_.textFg)->setPos(base.topLeft());
 
         base.moveTop(base.top() + coreStatSize_.offset);
 
@@ -1184,14 +1372,11 @@ auto Canvas::renderCoreStat(bool mode) -> void
             }
 
             fg.setColor(colorSrc_.force[src->second]);
-            group_.coreStat->addToGroup(symbol(j, fg, base));
+            symbol(batch, j, fg.color(), base.topLeft());
 
-            auto numItem (new QGraphicsSimpleTextItem(
-                QString("%1").arg(std::round((j > 17 ? bScale : eScale) * src->first), 2)));
-            numItem->setFont(font_.canvasTxt);
-            numItem->setBrush(fg.brush());
+            auto numItem (pool.text(
+                QString("%1").arg(std::round((j > 17 ? bScale : eScale) * src->first), 2), font_.canvasTxt, fg.brush()));
             numItem->setPos(base.bottomLeft() + coreStatSize_.numDp);
-            group_.coreStat->addToGroup(numItem);
 
             base.moveLeft(base.left() + coreStatSize_.offset);
         }
@@ -1205,13 +1390,12 @@ auto Canvas::renderCoreStat(bool mode) -> void
         if (mapType.second != NONE)
             coreStr += ", " + mapType.first;
 
-        auto coreItem (new QGraphicsSimpleTextItem(coreStr));
-        coreItem->setFont(font_.canvasTxt);
-        coreItem->setBrush(colorSrc_.textFg);
-        coreItem->setPos(base.topLeft());
-        group_.coreStat->addToGroup(coreItem);
+        pool.text(coreStr, font_.canvasTxt, colorSrc_.textFg)->setPos(base.topLeft());
     }
 
+    drawSymbols(pool, batch);
+    pool.flush();
+
     if (trigger_.coreStatCosEnb || trigger_.coreStatHorEnb)
     {
         cmap_.coreStat = coreStatSize_.rect;
@@ -1234,238 +1418,238 @@ auto Canvas::renderCoreStat(bool mode) -> void
 }
 
 
-auto Canvas::cleanGroup(QGraphicsItemGroup* group) -> void
+auto Canvas::makeSymbols(double side) -> void
 {
-    for(auto item : scene_->items(group->boundingRect()))
-        if(item->group() == group)
-            delete item;
-}
-
+    QRectF base (0, 0, side, side);
 
-auto Canvas::symbol(int ind, const QPen& fg, const QRectF& base) -> QGraphicsItemGroup*
-{
-    auto group (new QGraphicsItemGroup);
+    for (auto ind (0); ind < static_cast<int>(symbolPath_.size()); ++ind)
+    {
+        auto& [line, fill, glyph] (symbolPath_[ind]);
 
-    switch (ind) {
-    case 0 :
-    case 1 :
-    case 2 :
-    case 3 :
-    {// Elements
-        QPointF p1, p2, p3;
+        line.clear();
+        fill.clear();
+        glyph.clear();
+        glyph.setFillRule(Qt::WindingFill);
 
-        if (ind == 0 || ind == 2)
-        {
-            p1 = base.topLeft() + QPointF(0.5 * base.width(), 0);
-            p2 = base.bottomLeft();
-            p3 = base.bottomRight();
-        }
-        else
-        {
-            p1 = base.bottomLeft() + QPointF(0.5 * base.width(), 0);
-            p2 = base.topLeft();
-            p3 = base.topRight();
-        }
+        switch (ind) {
+        case 0 :
+        case 1 :
+        case 2 :
+        case 3 :
+        {// Elements
+            QPointF p1, p2, p3;
 
-        auto symItem (new QGraphicsPolygonItem({p1, p2, p3}));
-        symItem->setPen(fg);
-        symItem->setBrush(Qt::NoBrush);
-        group->addToGroup(symItem);
+            if (ind == 0 || ind == 2)
+            {
+                p1 = base.topLeft() + QPointF(0.5 * base.width(), 0);
+                p2 = base.bottomLeft();
+                p3 = base.bottomRight();
+            }
+            else
+            {
+                p1 = base.bottomLeft() + QPointF(0.5 * base.width(), 0);
+                p2 = base.topLeft();
+                p3 = base.topRight();
+            }
 
-        if (ind == 2 || ind == 3)
-        {
-            auto insItem (new QGraphicsLineItem({QLineF(p1, p2).pointAt(0.7), QLineF(p1, p3).pointAt(0.7)}));
-            insItem->setPen(fg);
-            group->addToGroup(insItem);
-        }
+            line.addPolygon({p1, p2, p3});
+            line.closeSubpath();
 
-        return group;
-    }
-    case 4 :
-    case 5 :
-    case 6 :
-    case 7 :
-    case 8 :
-    case 9 :
-    case 10 :
-    case 21 :
-    case 22 :
-    case 23 :
-    case 24 :
-    case 25 :
-    case 26 :
-    {// Square symbols
-        auto symItem (new QGraphicsRectItem(base));
-        symItem->setPen(fg);
-        symItem->setBrush(Qt::NoBrush);
-        group->addToGroup(symItem);
-
-        break;
-    }
-    case 11 :
-    case 12 :
-    case 13 :
-    case 14 :
-    case 15 :
-    case 16 :
-    case 17 :
-    case 18 :
-    case 19 :
-    case 20 :
-        // Round symbols
-        auto symItem (new QGraphicsEllipseItem(base));
-        symItem->setPen(fg);
-        symItem->setBrush(Qt::NoBrush);
-        group->addToGroup(symItem);
-    }
+            if (ind == 2 || ind == 3)
+            {
+                line.moveTo(QLineF(p1, p2).pointAt(0.7));
+                line.lineTo(QLineF(p1, p3).pointAt(0.7));
+            }
 
-    switch (ind) {
-    case 4 :
-    case 18 :
-    {// Point
-        QRectF point (0, 0, 2 * scale_, 2 * scale_);
-        point.moveCenter(base.center());
-        auto insItem (new QGraphicsEllipseItem(point));
-        insItem->setPen(fg);
-        insItem->setBrush(fg.brush());
-        group->addToGroup(insItem);
-
-        break;
-    }
-    case 5 :
-    case 19 :
-    case 6 :
-    case 20 :
-    {
-        auto rect = base.adjusted(1.5 * scale_, 1.5 * scale_, -1.5 * scale_, -1.5 * scale_);
-        QPointF offset (0.5 * rect.width(), 0);
-        QPointF p1 (rect.topLeft() + offset);
-        QPointF p2 (rect.center() + offset);
-        QPointF p3 (rect.bottomLeft() + offset);
-        QPointF p4 (rect.center() - offset);
-
-        if (ind == 5 || ind == 19)
-        {// Cross
-            auto insItem (new QGraphicsLineItem({p1, p3}));
-            insItem->setPen(fg);
-            group->addToGroup(insItem);
-            insItem = new QGraphicsLineItem({p2, p4});
-            insItem->setPen(fg);
-            group->addToGroup(insItem);
+            continue;
         }
-        else
-        {// Romb
-            auto insItem (new QGraphicsPolygonItem({p1, p2, p3, p4}));
-            insItem->setPen(fg);
-            insItem->setBrush(Qt::NoBrush);
-            group->addToGroup(insItem);
+        case 4 :
+        case 5 :
+        case 6 :
+        case 7 :
+        case 8 :
+        case 9 :
+        case 10 :
+        case 21 :
+        case 22 :
+        case 23 :
+        case 24 :
+        case 25 :
+        case 26 :
+            // Square symbols
+            line.addRect(base);
+            break;
+        case 11 :
+        case 12 :
+        case 13 :
+        case 14 :
+        case 15 :
+        case 16 :
+        case 17 :
+        case 18 :
+        case 19 :
+        case 20 :
+            // Round symbols
+            line.addEllipse(base);
         }
 
-        break;
-    }
-    case 7 :
-    case 8 :
-    case 9 :
-    case 10 :
-    {// Quadrants
-        auto rect (base.adjusted(0, 0, -0.5 * base.width(), -0.5 * base.height()));
-
         switch (ind) {
-        case 7 :
-            rect.moveBottomRight(base.bottomRight());
+        case 4 :
+        case 18 :
+        {// Point
+            QRectF point (0, 0, 2 * scale_, 2 * scale_);
+            point.moveCenter(base.center());
+            fill.addEllipse(point);
+
             break;
-        case 8 :
-            rect.moveBottomLeft(base.bottomLeft());
+        }
+        case 5 :
+        case 19 :
+        case 6 :
+        case 20 :
+        {
+            auto rect = base.adjusted(1.5 * scale_, 1.5 * scale_, -1.5 * scale_, -1.5 * scale_);
+            QPointF offset (0.5 * rect.width(), 0);
+            QPointF p1 (rect.topLeft() + offset);
+            QPointF p2 (rect.center() + offset);
+            QPointF p3 (rect.bottomLeft() + offset);
+            QPointF p4 (rect.center() - offset);
+
+            if (ind == 5 || ind == 19)
+            {// Cross
+                line.moveTo(p1);
+                line.lineTo(p3);
+                line.moveTo(p2);
+                line.lineTo(p4);
+            }
+            else
+            {// Romb
+                line.addPolygon({p1, p2, p3, p4});
+                line.closeSubpath();
+            }
+
             break;
+        }
+        case 7 :
+        case 8 :
         case 9 :
-            rect.moveTopLeft(base.topLeft());
-            break;
         case 10 :
-            rect.moveTopRight(base.topRight());
-        }
+        {// Quadrants
+            auto rect (base.adjusted(0, 0, -0.5 * base.width(), -0.5 * base.height()));
 
-        auto insItem (new QGraphicsRectItem(rect));
-        insItem->setPen(fg);
-        insItem->setBrush(fg.brush());
-        group->addToGroup(insItem);
+            switch (ind) {
+            case 7 :
+                rect.moveBottomRight(base.bottomRight());
+                break;
+            case 8 :
+                rect.moveBottomLeft(base.bottomLeft());
+                break;
+            case 9 :
+                rect.moveTopLeft(base.topLeft());
+                break;
+            case 10 :
+                rect.moveTopRight(base.topRight());
+            }
 
-        break;
-    }
-    case 11 :
-    case 12 :
-    case 13 :
-    case 14 :
-    case 15 :
-    case 16 :
-    case 17 :
-    {// Zones and hemispheres
-        auto start (0);
-        auto span (0);
+            fill.addRect(rect);
 
-        switch (ind) {
-        case 11 :
-            start = 0;
-            span = -1920;
             break;
+        }
+        case 11 :
         case 12 :
-            start = -1920;
-            span = -1920;
-            break;
         case 13 :
-            start = -3840;
-            span = -1920;
-            break;
         case 14 :
-            start = -2880;
-            span = -2880;
-            break;
         case 15 :
-            start = 0;
-            span = -2880;
-            break;
         case 16 :
-            start = 1440;
-            span = -2880;
-            break;
         case 17 :
-            start = -1440;
-            span = -2880;
+        {// Zones and hemispheres
+            auto start (0);
+            auto span (0);
+
+            switch (ind) {
+            case 11 :
+                start = 0;
+                span = -120;
+                break;
+            case 12 :
+                start = -120;
+                span = -120;
+                break;
+            case 13 :
+                start = -240;
+                span = -120;
+                break;
+            case 14 :
+                start = -180;
+                span = -180;
+                break;
+            case 15 :
+                start = 0;
+                span = -180;
+                break;
+            case 16 :
+                start = 90;
+                span = -180;
+                break;
+            case 17 :
+                start = -90;
+                span = -180;
+            }
+
+            fill.moveTo(base.center());
+            fill.arcTo(base, start, span);
+            fill.closeSubpath();
+
+            break;
         }
+        case 21 :
+        case 22 :
+        case 23 :
+        case 24 :
+        case 25 :
+        case 26 :
+            // Aspect symbols, a path starts the text at its baseline
+            auto isMini (ind == 24 || ind == 25);
+            auto& font (isMini ? font_.miniSymB : font_.miniSymA);
+            QString sym (QString("qweQN+")[ind-21]);
 
-        auto insItem (new QGraphicsEllipseItem(base));
-        insItem->setPen(fg);
-        insItem->setBrush(fg.brush());
-        insItem->setStartAngle(start);
-        insItem->setSpanAngle(span);
-        group->addToGroup(insItem);
+            QPointF crutch (0, QFontMetricsF(font).ascent() + (isMini ? 0 : scale_));
 
-        break;
+            glyph.addText(base.center() - metrics_.rect(font, sym).center() + crutch, font, sym);
+        }
     }
-    case 21 :
-    case 22 :
-    case 23 :
-    case 24 :
-    case 25 :
-    case 26 :
-        // Aspect symbols
-        auto insItem (new QGraphicsSimpleTextItem(QString("qweQN+")[ind-21]));
-        insItem->setBrush(fg.brush());
-
-        QPointF crutch (0, 0);
-
-        if (ind == 24 || ind == 25)
-            insItem->setFont(font_.miniSymB);
-        else
+}
+
+
+auto Canvas::symbol(SymbolBatch& batch, int ind, const QColor& color, const QPointF& pos) const -> void
+{
+    auto& src (symbolPath_[ind]);
+    auto& dst (batch[color.rgba()]);
+
+    dst.line.addPath(src.line.translated(pos));
+    dst.fill.addPath(src.fill.translated(pos));
+    dst.glyph.addPath(src.glyph.translated(pos));
+}
+
+
+auto Canvas::drawSymbols(ItemPool& pool, SymbolBatch& batch) -> void
+{
+    // One item for each colour and kind of stroke, however many symbols the panel has
+    for (auto& [rgba, path] : batch)
+    {
+        auto fg (pen_.textFg);
+        fg.setColor(QColor::fromRgba(rgba));
+
+        if (!path.line.isEmpty())
+            pool.path(fg, Qt::NoBrush)->setPath(path.line);
+        if (!path.fill.isEmpty())
+            pool.path(fg, fg.brush())->setPath(path.fill);
+        if (!path.glyph.isEmpty())
         {
-            insItem->setFont(font_.miniSymA);
-            crutch.ry() += scale_;
+            path.glyph.setFillRule(Qt::WindingFill);
+            pool.path(Qt::NoPen, fg.brush())->setPath(path.glyph);
         }
-
-        insItem->setPos(base.center() - insItem->boundingRect().center() + crutch);
-        group->addToGroup(insItem);
     }
-
-    return group;
 }
 
 
@@ -2,6 +2,8 @@
 #define CANVAS_H
 
 #include <QGraphicsView>
+#include <QGraphicsPixmapItem>
+#include <QPicture>
 #include "CanvasBase.h"
 
 namespace napatahti {
@@ -22,20 +24,25 @@ public :
     auto renderRecepTree(bool mode=true) -> void;
     auto renderEsseStat(bool mode=true) -> void;
     auto renderCircle(bool mode=true) -> void;
-    auto renderAspects(QGraphicsItem* item=nullptr) -> void;
+    auto renderAspects() -> void;
     auto renderCrdTable(bool mode=true) -> void;
     auto renderLineBar(bool mode=true) -> void;
     auto renderAspCfg(bool mode=true) -> void;
     auto renderAspStat(bool mode=true) -> void;
     auto renderCoreStat(bool mode=true) -> void;
 
+    auto renderScene(const QSize& size) -> void;
+    auto toPicture() -> QPicture;
+
     auto& getContextMap() const { return cmap_; }
+    auto& getTrace() { return trace_; }
 
     static auto getPlanetSpace() { return circleSizeSrc_.value("space"); }
 
 public slots :
     void updateCache(int cMask=0);
     void onChangeBkg();
+    void onShowTrace(bool mode);
 
 signals :
     void sizeChanged(const QString& size);
@@ -49,15 +56,33 @@ private :
     QTimer*          timer_;
 
     SceneGroup group_;
+    ScenePool  pool_;
     ContextMap cmap_;
 
+    QGraphicsScene*      baseScene_;
+    QGraphicsPixmapItem* baseItem_;
+    ItemPool             basePool_;
+    std::size_t          baseStamp_;
+    double               baseScale_;
+
     QRect   geo_;
+    QSize   frame_;
+    int     aspect_;
     QPointF zeroPos_;
     double  zeroAng_;
     double  scale_;
 
-    CanvasFont font_;
-    CanvasPen  pen_;
+    CanvasFont  font_;
+    CanvasPen   pen_;
+    TextMetrics metrics_;
+
+    std::array<SymbolPath, 27> symbolPath_;
+
+    RenderTrace trace_;
+    bool        isTrace_;
+
+    std::map<QGraphicsItem*, MarkerCache> marker_;
+    QGraphicsItem*                        marked_;
 
     HeaderSizeCache   headerSize_;
     RecepSizeCache    recepSize_;
@@ -86,18 +111,31 @@ private :
     static QMap<QString, int> aspStatSizeSrc_;
     static QMap<QString, int> coreStatSizeSrc_;
 
+    static constexpr int baseHeight_ {929};
+    static constexpr int aspectSteps_ {16};
+
 private slots :
     void onRenderScene();
 
 private :
+    auto renderLayers() -> void;
+
     auto resizeEvent(QResizeEvent* event) -> void;
+    auto drawForeground(QPainter* painter, const QRectF& rect) -> void;
+    auto aspectClass() const -> int;
+    auto fitScene() -> void;
 
-    auto cleanGroup(QGraphicsItemGroup* group) -> void;
     auto renderMapBase() -> void;
+    auto paintMapBase(double scale) -> void;
     auto renderCuspids() -> void;
     auto renderPlanets() -> void;
+    auto renderMarkers(QGraphicsItem* item=nullptr) -> void;
+    auto dropMarkers() -> void;
+    auto drawAspects(ItemPool& pool, QGraphicsItem* item=nullptr) -> void;
 
-    auto symbol(int ind, const QPen& fg, const QRectF& base) -> QGraphicsItemGroup*;
+    auto makeSymbols(double side) -> void;
+    auto symbol(SymbolBatch& batch, int ind, const QColor& color, const QPointF& pos) const -> void;
+    auto drawSymbols(ItemPool& pool, SymbolBatch& batch) -> void;
 
     auto getKadData(int crd) const -> std::pair<QString, const QBrush*>;
 
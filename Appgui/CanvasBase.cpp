@@ -1,4 +1,9 @@
 #include <QEvent>
+#include <QFontMetricsF>
+#include <QTextStream>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QJsonDocument>
 #include "shared.h"
 #include "Kernel/RefBook.h"
 #include "Canvas.h"
@@ -9,10 +14,10 @@ auto ItemEventFilter::sceneEventFilter(QGraphicsItem* item, QEvent *event) -> bo
 {
     switch (event->type()) {
     case QEvent::GraphicsSceneHoverEnter :
-        canvas_->renderAspects(item);
+        canvas_->renderMarkers(item);
         return true;
     case QEvent::GraphicsSceneHoverLeave :
-        canvas_->cleanGroup(canvas_->group_.markers);
+        canvas_->renderMarkers();
         return true;
     default :
         return false;
@@ -20,6 +25,314 @@ auto ItemEventFilter::sceneEventFilter(QGraphicsItem* item, QEvent *event) -> bo
 }
 
 
+ItemPool::ItemPool(QGraphicsItemGroup* group, const prepare_t& prepare)
+    : group_ (group)
+    , prepare_ (prepare)
+{}
+
+
+auto ItemPool::reset() -> void
+{
+    text_.used = 0;
+    line_.used = 0;
+    ellipse_.used = 0;
+    polygon_.used = 0;
+    rect_.used = 0;
+    path_.used = 0;
+    depth_ = 0;
+}
+
+
+auto ItemPool::flush() -> void
+{
+    flush(text_);
+    flush(line_);
+    flush(ellipse_);
+    flush(polygon_);
+    flush(rect_);
+    flush(path_);
+}
+
+
+auto ItemPool::clear() -> void
+{
+    reset();
+    flush();
+}
+
+
+auto ItemPool::size() const -> std::size_t
+{
+    return text_.used + line_.used + ellipse_.used + polygon_.used + rect_.used + path_.used;
+}
+
+
+template <class T>
+auto ItemPool::take(Slot<T>& slot) -> T*
+{
+    if (slot.used == slot.item.size())
+    {
+        auto item (new T);
+        group_->addToGroup(item);
+
+        if (prepare_)
+            prepare_(item);
+
+        slot.item.push_back(item);
+    }
+
+    // Items of every kind are painted in the order they were asked for, as fresh ones were
+    auto item (slot.item[slot.used++]);
+    item->setZValue(depth_++);
+
+    return item;
+}
+
+
+template <class T>
+auto ItemPool::flush(Slot<T>& slot) -> void
+{
+    for (auto i (slot.used); i < slot.item.size(); ++i)
+        delete slot.item[i];
+
+    slot.item.resize(slot.used);
+}
+
+
+auto ItemPool::text(const QString& str, const QFont& font, const QBrush& brush, const QString& tip)
+    -> QGraphicsSimpleTextItem*
+{
+    auto item (take(text_));
+
+    // Setters relayout the text even for equal values, so only changes are passed on
+    if (item->text() != str)
+        item->setText(str);
+    if (item->font() != font)
+        item->setFont(font);
+    if (item->brush() != brush)
+        item->setBrush(brush);
+    if (item->toolTip() != tip)
+        item->setToolTip(tip);
+
+    return item;
+}
+
+
+auto ItemPool::line(const QPen& pen) -> QGraphicsLineItem*
+{
+    auto item (take(line_));
+
+    if (item->pen() != pen)
+        item->setPen(pen);
+
+    return item;
+}
+
+
+auto ItemPool::ellipse(const QPen& pen, const QBrush& brush, int start, int span) -> QGraphicsEllipseItem*
+{
+    auto item (take(ellipse_));
+
+    if (item->pen() != pen)
+        item->setPen(pen);
+    if (item->brush() != brush)
+        item->setBrush(brush);
+
+    item->setStartAngle(start);
+    item->setSpanAngle(span);
+
+    return item;
+}
+
+
+auto ItemPool::polygon(const QPen& pen, const QBrush& brush) -> QGraphicsPolygonItem*
+{
+    auto item (take(polygon_));
+
+    if (item->pen() != pen)
+        item->setPen(pen);
+    if (item->brush() != brush)
+        item->setBrush(brush);
+
+    return item;
+}
+
+
+auto ItemPool::rect(const QPen& pen, const QBrush& brush) -> QGraphicsRectItem*
+{
+    auto item (take(rect_));
+
+    if (item->pen() != pen)
+        item->setPen(pen);
+    if (item->brush() != brush)
+        item->setBrush(brush);
+
+    return item;
+}
+
+
+auto ItemPool::path(const QPen& pen, const QBrush& brush) -> QGraphicsPathItem*
+{
+    auto item (take(path_));
+
+    if (item->pen() != pen)
+        item->setPen(pen);
+    if (item->brush() != brush)
+        item->setBrush(brush);
+
+    return item;
+}
+
+
+auto TextMetrics::rect(const QFont& font, const QString& text) -> QRectF
+{
+    auto key (std::make_pair(font, text));
+    auto iter (cache_.constFind(key));
+
+    if (iter != cache_.cend())
+        return *iter;
+
+    // Header and numbers change with every step, old strings are dropped wholesale
+    if (cache_.size() >= capacity_)
+        cache_.clear();
+
+    // The box a text item reports: the widest line without trailing blanks,
+    // line heights with the leading between them
+    QRectF rect;
+    if (!text.isEmpty())
+    {
+        QFontMetricsF metrics (font);
+        auto lines (text.split('\n'));
+        qreal width (0);
+
+        for (auto& i : lines)
+        {
+            auto len (i.size());
+            while (len > 0 && i[len - 1].isSpace())
+                --len;
+
+            width = std::max(width, metrics.horizontalAdvance(i, len));
+        }
+
+        auto count (static_cast<int>(lines.size()));
+        rect.setSize({width, count * metrics.height() + (count - 1) * metrics.leading()});
+    }
+
+    return *cache_.insert(key, rect);
+}
+
+
+RenderTrace::Scope::Scope(RenderTrace& trace, const char* name, const char* cat, const ItemPool* pool)
+    : trace_ (trace)
+    , name_ (name)
+    , cat_ (cat)
+    , pool_ (pool)
+    , start_ (trace.now())
+{}
+
+
+RenderTrace::Scope::~Scope()
+{
+    auto items (pool_ != nullptr ? static_cast<int>(pool_->size()) : NONE);
+    trace_.push({name_, cat_, start_, trace_.now() - start_, items});
+}
+
+
+RenderTrace::RenderTrace()
+    : next_ (0)
+{
+    timer_.start();
+    event_.reserve(capacity_);
+}
+
+
+auto RenderTrace::toStrStat() const -> QString
+{
+    struct Stat {
+        qint64 sum {0};
+        qint64 max {0};
+        int    count {0};
+        int    items {NONE};
+    };
+
+    std::map<std::pair<QString, QString>, Stat> stat;
+
+    for (auto i : ordered())
+    {
+        auto& s (stat[{i->cat, i->name}]);
+        s.sum += i->span;
+        s.max = std::max(s.max, i->span);
+        s.items = i->items;
+        ++s.count;
+    }
+
+    QString res;
+    QTextStream out (&res);
+
+    out << QString("%1 %2 %3 %4\n").arg("stage", -22).arg("avg ms", 8).arg("max ms", 8).arg("items", 6);
+
+    for (auto& [key, s] : stat)
+        out << QString("%1 %2 %3 %4\n")
+                   .arg(key.first + '/' + key.second, -22)
+                   .arg(0.001 * s.sum / s.count, 8, 'f', 3)
+                   .arg(0.001 * s.max, 8, 'f', 3)
+                   .arg(s.items == NONE ? QString("-") : QString::number(s.items), 6);
+
+    return res.trimmed();
+}
+
+
+auto RenderTrace::toJson() const -> QByteArray
+{
+    QJsonArray trace;
+
+    // Complete events of the trace event format, time in microseconds
+    for (auto i : ordered())
+    {
+        QJsonObject event {
+            {"name", i->name},
+            {"cat", i->cat},
+            {"ph", "X"},
+            {"ts", i->start},
+            {"dur", i->span},
+            {"pid", 1},
+            {"tid", 1}};
+
+        if (i->items != NONE)
+            event.insert("args", QJsonObject {{"items", i->items}});
+
+        trace.push_back(event);
+    }
+
+    return QJsonDocument(QJsonObject {{"traceEvents", trace}, {"displayTimeUnit", "ms"}}).toJson();
+}
+
+
+auto RenderTrace::push(const Event& event) -> void
+{
+    // A ring, the oldest events give way once it is full
+    if (event_.size() < capacity_)
+        event_.push_back(event);
+    else
+        event_[next_] = event;
+
+    next_ = (next_ + 1) % capacity_;
+}
+
+
+auto RenderTrace::ordered() const -> std::vector<const Event*>
+{
+    std::vector<const Event*> res;
+    res.reserve(event_.size());
+
+    auto begin (event_.size() < capacity_ ? 0 : next_);
+    for (std::size_t i (0); i < event_.size(); ++i)
+        res.push_back(&event_[(begin + i) % event_.size()]);
+
+    return res;
+}
+
+
 auto CanvasColor::getSpec(const std::array<int, 2>& key) const -> const QBrush&
 {
     auto iter (RefBook::specState.find(key));
@@ -1,8 +1,14 @@
 #ifndef CANVASBASE_H
 #define CANVASBASE_H
 
+#include <functional>
+#include <vector>
+#include <map>
 #include <QFont>
 #include <QPen>
+#include <QHash>
+#include <QElapsedTimer>
+#include <QPainterPath>
 #include <QGraphicsSimpleTextItem>
 
 namespace napatahti {
@@ -40,6 +46,143 @@ struct SceneGroup {
 };
 
 
+class ItemPool
+{
+public :
+    using prepare_t = std::function<void(QGraphicsItem*)>;
+
+    ItemPool() {}
+    explicit ItemPool(QGraphicsItemGroup* group, const prepare_t& prepare={});
+
+    auto reset() -> void;
+    auto flush() -> void;
+    auto clear() -> void;
+    auto size() const -> std::size_t;
+
+    auto text(const QString& str, const QFont& font, const QBrush& brush, const QString& tip={})
+        -> QGraphicsSimpleTextItem*;
+    auto line(const QPen& pen) -> QGraphicsLineItem*;
+    auto ellipse(const QPen& pen, const QBrush& brush, int start=0, int span=5760) -> QGraphicsEllipseItem*;
+    auto polygon(const QPen& pen, const QBrush& brush) -> QGraphicsPolygonItem*;
+    auto rect(const QPen& pen, const QBrush& brush) -> QGraphicsRectItem*;
+    auto path(const QPen& pen, const QBrush& brush) -> QGraphicsPathItem*;
+
+private :
+    template <class T>
+    struct Slot {
+        std::vector<T*> item;
+        std::size_t     used {0};
+    };
+
+    QGraphicsItemGroup* group_ {nullptr};
+    prepare_t           prepare_;
+    double              depth_ {0};
+
+    Slot<QGraphicsSimpleTextItem> text_;
+    Slot<QGraphicsLineItem>       line_;
+    Slot<QGraphicsEllipseItem>    ellipse_;
+    Slot<QGraphicsPolygonItem>    polygon_;
+    Slot<QGraphicsRectItem>       rect_;
+    Slot<QGraphicsPathItem>       path_;
+
+private :
+    template <class T>
+    auto take(Slot<T>& slot) -> T*;
+    template <class T>
+    auto flush(Slot<T>& slot) -> void;
+};
+
+
+struct SymbolPath {
+    QPainterPath line;
+    QPainterPath fill;
+    QPainterPath glyph;
+};
+
+using SymbolBatch = std::map<QRgb, SymbolPath>;
+
+
+struct MarkerCache {
+    QGraphicsItemGroup* group;
+    ItemPool            pool;
+    bool                isValid;
+};
+
+
+class TextMetrics
+{
+public :
+    auto rect(const QFont& font, const QString& text) -> QRectF;
+
+private :
+    QHash<std::pair<QFont, QString>, QRectF> cache_;
+
+    static constexpr int capacity_ {4096};
+};
+
+
+class RenderTrace
+{
+public :
+    class Scope
+    {
+    public :
+        explicit Scope(RenderTrace& trace, const char* name, const char* cat="canvas",
+                       const ItemPool* pool=nullptr);
+        ~Scope();
+
+    private :
+        RenderTrace&    trace_;
+        const char*     name_;
+        const char*     cat_;
+        const ItemPool* pool_;
+        qint64          start_;
+    };
+
+    explicit RenderTrace();
+
+    auto toStrStat() const -> QString;
+    auto toJson() const -> QByteArray;
+
+private :
+    struct Event {
+        const char* name;
+        const char* cat;
+        qint64      start;
+        qint64      span;
+        int         items;
+    };
+
+    QElapsedTimer      timer_;
+    std::vector<Event> event_;
+    std::size_t        next_;
+
+    static constexpr int capacity_ {8192};
+
+private :
+    auto now() const { return timer_.nsecsElapsed() / 1000; }
+    auto push(const Event& event) -> void;
+    auto ordered() const -> std::vector<const Event*>;
+};
+
+
+struct ScenePool {
+    ItemPool header;
+    ItemPool recepTree;
+    ItemPool esseStat;
+    ItemPool crdTable;
+    ItemPool lineBar;
+    ItemPool aspCfg;
+    ItemPool aspStat;
+    ItemPool coreStat;
+    ItemPool circle;
+    ItemPool aspects;
+
+    auto begin() { return &header; }
+    auto end() { return &aspects + 1; }
+};
+
+
 struct CanvasFont {
     QFont aspMarkTxt {"Arial", 8};
     QFont aspMarkSym {"HamburgSymbols", 12};
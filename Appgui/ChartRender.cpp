@@ -0,0 +1,92 @@
+#include <QFileInfo>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QSvgGenerator>
+#include "MainWindow.h"
+#include "ChartRender.h"
+
+namespace napatahti {
+
+ChartRender::ChartRender()
+    : kernel_ ()
+    , canvas_ (kernel_)
+{}
+
+
+auto ChartRender::record(const Person& person, const QSize& size) -> QPicture
+{
+    // A kernel and a canvas of its own, the main window keeps its chart
+    kernel_.person() = person;
+    kernel_.setHeaderStr();
+    kernel_.updateChart(Canvas::getPlanetSpace(), MainWindow::getTrigger().aspCfgClassOnly);
+
+    canvas_.renderScene(size);
+
+    return canvas_.toPicture();
+}
+
+
+auto ChartRender::save(const QPicture& picture, const QString& fileName, const QSize& size) -> bool
+{
+    if (size.isEmpty())
+        return false;
+
+    // Only painting happens here, so a batch job may call it from worker threads
+    auto suffix (QFileInfo(fileName).suffix().toLower());
+
+    if (suffix == "svg")
+    {
+        QSvgGenerator svg;
+        svg.setFileName(fileName);
+        svg.setSize(size);
+        svg.setViewBox(QRect({0, 0}, size));
+        svg.setTitle(QFileInfo(fileName).completeBaseName());
+
+        return paint(picture, &svg);
+    }
+
+    if (suffix == "pdf")
+    {
+        QPdfWriter pdf (fileName);
+        pdf.setPageSize(QPageSize(QSizeF(size), QPageSize::Point));
+        pdf.setPageMargins(QMarginsF());
+        pdf.setTitle(QFileInfo(fileName).completeBaseName());
+
+        return paint(picture, &pdf);
+    }
+
+    QImage image (size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+
+    return paint(picture, &image) && image.save(fileName, suffix.isEmpty() ? "png" : nullptr);
+}
+
+
+auto ChartRender::paint(const QPicture& picture, QPaintDevice* device) -> bool
+{
+    QRectF source (picture.boundingRect());
+    if (source.isEmpty())
+        return false;
+
+    QPainter painter (device);
+    QRectF target (painter.viewport());
+
+    // Centered at the largest scale that fits, in the units of the device
+    auto k (std::min(target.width() / source.width(), target.height() / source.height()));
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.translate(target.center());
+    painter.scale(k, k);
+    painter.translate(-source.center());
+    painter.drawPicture(0, 0, picture);
+
+    return painter.end();
+}
+
+
+auto ChartRender::getFilter() -> QString
+{
+    return tr("Image") + " (*.png);;" + tr("Vector image") + " (*.svg);;PDF (*.pdf)";
+}
+
+} // namespace napatahti
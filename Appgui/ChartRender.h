@@ -0,0 +1,31 @@
+#ifndef CHARTRENDER_H
+#define CHARTRENDER_H
+
+#include <QPicture>
+#include <QCoreApplication>
+#include "Kernel/Kernel.h"
+#include "Canvas.h"
+
+namespace napatahti {
+
+class ChartRender
+{
+    Q_DECLARE_TR_FUNCTIONS(ChartRender)
+
+public :
+    explicit ChartRender();
+
+    auto record(const Person& person, const QSize& size) -> QPicture;
+
+    static auto save(const QPicture& picture, const QString& fileName, const QSize& size) -> bool;
+    static auto paint(const QPicture& picture, QPaintDevice* device) -> bool;
+    static auto getFilter() -> QString;
+
+private :
+    Kernel kernel_;
+    Canvas canvas_;
+};
+
+} // namespace napatahti
+
+#endif // CHARTRENDER_H
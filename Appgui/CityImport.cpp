@@ -0,0 +1,157 @@
+#include <QFileInfo>
+#include <QDir>
+#include <QTimeZone>
+#include "shared.h"
+#include "AtlasDialog.h"
+#include "CityImport.h"
+
+namespace napatahti {
+
+CityImport::CityImport(SqlConnection& dbase)
+    : ImportBase (dbase)
+    , insert_ (nullptr)
+    , line_ (0)
+{}
+
+
+auto CityImport::begin(const QString&, QFile& file, QTextStream&) -> bool
+{
+    // Region and country names come from the dumps lying beside
+    loadNames(QFileInfo(file).absolutePath());
+
+    insert_ = &dbase_.prepare(mask_.insert);
+    line_ = 0;
+
+    return true;
+}
+
+
+auto CityImport::next(QTextStream& stream) -> Step
+{
+    auto text (stream.readLine());
+    auto line (++line_);
+
+    if (text.isEmpty() || text.startsWith('#'))
+        return Step::Skip;
+
+    auto field (text.split('\t'));
+
+    // Only populated places are taken, the dump holds mountains and rivers too
+    if (field.size() > Field::Class && !field[Field::Class].isEmpty() && field[Field::Class] != "P")
+        return Step::Skip;
+
+    ++report_.read;
+
+    if (field.size() <= Field::Zone)
+    {
+        skip(line, "not a GeoNames row");
+        return Step::Skip;
+    }
+
+    auto okLat (true), okLon (true);
+    auto lat (qRound(3600 * field[Field::Lat].toDouble(&okLat)));
+    auto lon (qRound(3600 * field[Field::Lon].toDouble(&okLon)));
+
+    if (!okLat || !okLon || std::abs(lat) > 90 * 3600 || std::abs(lon) > 180 * 3600)
+    {
+        skip(line, "bad coordinates");
+        return Step::Skip;
+    }
+
+    auto utc (toUtc(field[Field::Zone]));
+
+    if (!utc)
+    {
+        skip(line, "unknown time zone " + field[Field::Zone]);
+        return Step::Skip;
+    }
+
+    auto title (toTitle(field));
+
+    insert_->addBindValue(title);
+    insert_->addBindValue(AtlasDialog::toKey(title));
+    insert_->addBindValue(*utc);
+    insert_->addBindValue(lat);
+    insert_->addBindValue(lon);
+
+    // The key is (title, utc)
+    insert(*insert_, line);
+
+    return Step::Row;
+}
+
+
+auto CityImport::loadNames(const QString& dir) -> void
+{
+    country_.clear();
+    admin_.clear();
+
+    // ISO code in the first column, the name in the fifth
+    QFile country (QDir(dir).filePath(countryFile_));
+
+    if (country.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        QTextStream stream (&country);
+
+        while (!stream.atEnd())
+        {
+            auto field (stream.readLine().split('\t'));
+            if (field.size() > 4 && !field[0].startsWith('#'))
+                country_.insert(field[0], field[4]);
+        }
+    }
+
+    // "RU.38" in the first column, the name in the second
+    QFile admin (QDir(dir).filePath(adminFile_));
+
+    if (admin.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        QTextStream stream (&admin);
+
+        while (!stream.atEnd())
+        {
+            auto field (stream.readLine().split('\t'));
+            if (field.size() > 1)
+                admin_.insert(field[0], field[1]);
+        }
+    }
+}
+
+
+auto CityImport::toTitle(const QStringList& field) const -> QString
+{
+    auto& code (field[Field::Country]);
+    QStringList title {field[Field::Name]};
+
+    auto admin (admin_.value(code + '.' + field[Field::Admin1]));
+    if (!admin.isEmpty() && admin != title[0])
+        title.push_back(admin);
+
+    // Without the country list the code stands for the country
+    auto country (country_.value(code, code));
+    if (!country.isEmpty())
+        title.push_back(country);
+
+    return title.join(", ");
+}
+
+
+auto CityImport::toUtc(const QString& zone) -> std::optional<int>
+{
+    auto check (zone_.constFind(zone));
+    if (check != zone_.cend())
+        return *check;
+
+    // The atlas keeps the standard offset of the zone, as the city dialog
+    QTimeZone timeZone (zone.toLatin1());
+    std::optional<int> utc;
+
+    if (timeZone.isValid())
+        utc = timeZone.standardTimeOffset(QDateTime::currentDateTimeUtc());
+
+    zone_.insert(zone, utc);
+
+    return utc;
+}
+
+} // namespace napatahti
@@ -0,0 +1,49 @@
+#ifndef CITYIMPORT_H
+#define CITYIMPORT_H
+
+#include <optional>
+#include <QHash>
+#include "ImportBase.h"
+
+namespace napatahti {
+
+class CityImport : public ImportBase
+{
+public :
+    explicit CityImport(SqlConnection& dbase);
+
+    using ImportBase::exec;
+
+public :
+    struct SqlMask {
+        QString insert {"INSERT OR IGNORE INTO city (title, title_key, utc, lat, lon) VALUES (?, ?, ?, ?, ?);"};
+    };
+
+private :
+    // Columns of a GeoNames dump, see readme.txt of the download server
+    enum Field { Id, Name, AsciiName, AltNames, Lat, Lon, Class, Code, Country,
+                 Cc2, Admin1, Admin2, Admin3, Admin4, Population, Elevation, Dem, Zone, Count };
+
+    QHash<QString, QString> country_;
+    QHash<QString, QString> admin_;
+    QHash<QString, std::optional<int>> zone_;
+
+    QSqlQuery* insert_;
+    int        line_;
+
+    static const SqlMask mask_;
+    static const QString countryFile_;
+    static const QString adminFile_;
+
+private :
+    auto begin(const QString& fileName, QFile& file, QTextStream& stream) -> bool;
+    auto next(QTextStream& stream) -> Step;
+
+    auto loadNames(const QString& dir) -> void;
+    auto toTitle(const QStringList& field) const -> QString;
+    auto toUtc(const QString& zone) -> std::optional<int>;
+};
+
+} // namespace napatahti
+
+#endif // CITYIMPORT_H
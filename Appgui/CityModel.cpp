@@ -0,0 +1,140 @@
+#include <QApplication>
+#include "CityModel.h"
+
+namespace napatahti {
+
+CityModel::CityModel(SqlConnection& dbase, QObject* root)
+    : PagedModel (dbase, {mask_.count, mask_.page, mask_.seek, mask_.rank}, root)
+    , isIndexed_ (false)
+{}
+
+
+auto CityModel::findRow(const QString& title, int utc) const -> int
+{
+    auto row (NONE);
+
+    if (!isOpen())
+        return row;
+
+    auto& query (dbase_.prepare(mask_.locate.arg(sortKey())));
+    query.addBindValue(title);
+    query.addBindValue(utc);
+
+    if (query.exec() && query.next())
+        row = rankOf(query);
+
+    query.finish();
+
+    return row;
+}
+
+
+auto CityModel::findPrefix(const QString& text) const -> int
+{
+    auto row (NONE);
+
+    if (!isOpen())
+        return row;
+
+    QString mask (text);
+    mask.replace("\\", "\\\\").replace("%", "\\%").replace("_", "\\_");
+
+    auto& query (dbase_.prepare(mask_.prefix.arg(sortKey()).arg(orderStr())));
+    query.addBindValue(mask + '%');
+
+    if (query.exec() && query.next())
+        row = rankOf(query);
+
+    query.finish();
+
+    return row;
+}
+
+
+auto CityModel::findText(const QString& text) const -> int
+{
+    // Trigrams need three characters, shorter input stays a title prefix
+    if (!isIndexed_ || text.size() < 3)
+        return findPrefix(text);
+
+    auto row (NONE);
+
+    if (!isOpen())
+        return row;
+
+    auto& query (dbase_.prepare(mask_.search.arg(sortKey())));
+    query.addBindValue('"' + QString(text).replace("\"", "\"\"") + '"');
+
+    if (query.exec() && query.next())
+        row = rankOf(query);
+
+    query.finish();
+
+    return row;
+}
+
+
+auto CityModel::columnCount(const QModelIndex& parent) const -> int
+{
+    return parent.isValid() ? 0 : 4;
+}
+
+
+auto CityModel::data(const QModelIndex& index, int role) const -> QVariant
+{
+    if (!index.isValid())
+        return {};
+
+    auto column (index.column());
+
+    switch (role) {
+    case Qt::TextAlignmentRole :
+        if (column == 0)
+            return {};
+        return static_cast<int>(Qt::AlignCenter);
+    case Qt::DisplayRole :
+        break;
+    default :
+        return {};
+    }
+
+    // Cells are formatted here, only for the rows being painted
+    auto city (getCity(index.row()));
+    if (city == nullptr)
+        return {};
+
+    switch (column) {
+    case 0 :
+        return city->title;
+    case 1 :
+        return toStrUtc(city->utc, false);
+    case 2 :
+        return toStrCrd(city->lat, true);
+    case 3 :
+        return toStrCrd(city->lon, false);
+    default :
+        return {};
+    }
+}
+
+
+auto CityModel::headerData(int section, Qt::Orientation orientation, int role) const -> QVariant
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole || section < 0 || section > 3)
+        return {};
+
+    return QApplication::translate("AtlasDialog", header_[section]);
+}
+
+
+auto CityModel::makeRow(const QSqlQuery& query) const -> City
+{
+    return {
+        query.value("title").toString(),
+        query.value("utc").toInt(),
+        query.value("lat").toInt(),
+        query.value("lon").toInt()
+    };
+}
+
+} // namespace napatahti
@@ -0,0 +1,66 @@
+#ifndef CITYMODEL_H
+#define CITYMODEL_H
+
+#include <array>
+#include "PagedModel.h"
+
+namespace napatahti {
+
+struct City {
+    QString title;
+    int utc;
+    int lat;
+    int lon;
+};
+
+
+class CityModel : public PagedModel<City>
+{
+    Q_OBJECT
+
+public :
+    using City = napatahti::City;
+
+    explicit CityModel(SqlConnection& dbase, QObject* root=nullptr);
+
+    auto setIndexed(bool indexed) { isIndexed_ = indexed; }
+
+    auto getCity(int row) const { return getRow(row); }
+    auto findRow(const QString& title, int utc) const -> int;
+    auto findPrefix(const QString& text) const -> int;
+    auto findText(const QString& text) const -> int;
+
+    auto columnCount(const QModelIndex& parent={}) const -> int;
+    auto data(const QModelIndex& index, int role=Qt::DisplayRole) const -> QVariant;
+    auto headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const -> QVariant;
+
+public :
+    struct SqlMask {
+        QString count {"SELECT COUNT(*) FROM city;"};
+        QString page {"SELECT rowid, %1 AS sortKey, * FROM city "
+                      "ORDER BY %1 %2, rowid %2 LIMIT ? OFFSET ?;"};
+        QString seek {"SELECT rowid, %1 AS sortKey, * FROM city WHERE (%1, rowid) %3 (?, ?) "
+                      "ORDER BY %1 %2, rowid %2 LIMIT ?;"};
+        QString locate {"SELECT rowid, %1 AS sortKey FROM city WHERE title=? AND utc=?;"};
+        QString prefix {"SELECT rowid, %1 AS sortKey FROM city WHERE title LIKE ? ESCAPE '\\' "
+                        "ORDER BY %1 %2, rowid %2 LIMIT 1;"};
+        QString rank {"SELECT COUNT(*) FROM city WHERE (%1, rowid) %2 (?, ?);"};
+        QString search {"SELECT rowid, %1 AS sortKey FROM city WHERE rowid = ("
+                            "SELECT rowid FROM city_fts WHERE city_fts MATCH ? ORDER BY rank LIMIT 1);"};
+    };
+
+private :
+    bool isIndexed_;
+
+    static const SqlMask mask_;
+    static const std::array<QString, 4> sortKey_;
+    static const std::array<const char*, 4> header_;
+
+private :
+    auto sortKey() const -> QString { return sortKey_[column_]; }
+    auto makeRow(const QSqlQuery& query) const -> City;
+};
+
+} // namespace napatahti
+
+#endif // CITYMODEL_H
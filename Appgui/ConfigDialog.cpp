@@ -13,6 +13,8 @@
 #include "Kernel/AspPage.h"
 #include "Kernel/AspTable.h"
 #include "Kernel/PrimeTest.h"
+#include "Kernel/KernelCache.h"
+#include "ImportBase.h"
 #include "MainWindow.h"
 #include "Canvas.h"
 #include "PersonDialog.h"
@@ -172,6 +174,8 @@ void ConfigDialog::onClickRedo()
         Person::hsys_ = hsysR_;
         AspTable::mvAcc_ = mvAccR_;
         PrimeTest::almuHard_ = almuHardR_;
+        KernelCache::capacity_ = cacheCapR_;
+        ImportBase::batch_ = importBatchR_;
 
         isSaveA_ = false;
         showGeneralSide();
@@ -602,6 +606,20 @@ void ConfigDialog::onAlmuHardChange(bool value)
 }
 
 
+void ConfigDialog::onCacheCapChange(int value)
+{
+    isSaveA_ = true;
+    KernelCache::capacity_ = value;
+}
+
+
+void ConfigDialog::onImportBatchChange(int value)
+{
+    isSaveA_ = true;
+    ImportBase::batch_ = value;
+}
+
+
 auto ConfigDialog::showEvent(QShowEvent* event) -> void
 {
     if (topHeight_ < 0)
@@ -633,6 +651,8 @@ auto ConfigDialog::copyReset() -> void
     hsysR_ = Person::hsys_;
     mvAccR_ = AspTable::mvAcc_;
     almuHardR_ = PrimeTest::almuHard_;
+    cacheCapR_ = KernelCache::capacity_;
+    importBatchR_ = ImportBase::batch_;
 
     fontSrcR_ = Canvas::fontSrc_;
     colorSrcR_ = Canvas::colorSrc_;
@@ -665,6 +685,8 @@ auto ConfigDialog::onReject(bool quit) -> void
         Person::hsys_ = hsysR_;
         AspTable::mvAcc_ = mvAccR_;
         PrimeTest::almuHard_ = almuHardR_;
+        KernelCache::capacity_ = cacheCapR_;
+        ImportBase::batch_ = importBatchR_;
     }
 
     if (isSaveB_)
@@ -751,6 +773,8 @@ auto ConfigDialog::showGeneralSide() -> void
 
     auto mvAccSpin (new QSpinBox(this));
     auto almuCheck (new QCheckBox(tr("Almuten by middle point") + " ", this));
+    auto cacheSpin (new QSpinBox(this));
+    auto batchSpin (new QSpinBox(this));
 
     auto localeBox (new QComboBox(this));
     auto infoLabel (new QLabel(tr("Application restart required to apply language."), this));
@@ -794,6 +818,18 @@ auto ConfigDialog::showGeneralSide() -> void
     almuCheck->setChecked(PrimeTest::almuHard_);
     almuCheck->setLayoutDirection(Qt::RightToLeft);
 
+    cacheSpin->setMinimum(0);
+    cacheSpin->setMaximum(1024);
+    cacheSpin->setPrefix(tr("Chart cache size") + "  :  ");
+    cacheSpin->setValue(KernelCache::capacity_);
+    cacheSpin->setSuffix(tr(" MB"));
+
+    batchSpin->setMinimum(1);
+    batchSpin->setMaximum(1000000);
+    batchSpin->setSingleStep(1000);
+    batchSpin->setPrefix(tr("Import batch size") + "  :  ");
+    batchSpin->setValue(ImportBase::batch_);
+
     localeBox->addItem(QLocale::languageToString(QLocale::English), "en_US");
 
     QDir locDir ("locale/");
@@ -822,12 +858,14 @@ auto ConfigDialog::showGeneralSide() -> void
     ui->grid->addLayout(dataHL, 2, 1, 1, 4);
     ui->grid->addWidget(mvAccSpin, 4, 1, 1, 2);
     ui->grid->addWidget(almuCheck, 4, 3, 1, 2);
+    ui->grid->addWidget(cacheSpin, 5, 1, 1, 2);
+    ui->grid->addWidget(batchSpin, 5, 3, 1, 2);
     ui->grid->addWidget(localeBox, 6, 1, 1, 2);
     ui->grid->addWidget(infoLabel, 7, 1, 1, 4);
 
     contList_ = {
         nameEdit, locEdit, atlasButton, saveButton, hsysBox,
-        latEdit, lonEdit, utcEdit, mvAccSpin, almuCheck, localeBox, infoLabel};
+        latEdit, lonEdit, utcEdit, mvAccSpin, almuCheck, localeBox, infoLabel, cacheSpin, batchSpin};
     boneList_ = {cityHL, dataHL};
 
     connect(nameEdit, &QLineEdit::textChanged, this, [this, nameEdit](){ personDefChanged(nameEdit); });
@@ -843,6 +881,8 @@ auto ConfigDialog::showGeneralSide() -> void
 
     connect(mvAccSpin, &QSpinBox::valueChanged, this, &ConfigDialog::onMapViewAccChange);
     connect(almuCheck, &QCheckBox::clicked, this, &ConfigDialog::onAlmuHardChange);
+    connect(cacheSpin, &QSpinBox::valueChanged, this, &ConfigDialog::onCacheCapChange);
+    connect(batchSpin, &QSpinBox::valueChanged, this, &ConfigDialog::onImportBatchChange);
 
     connect(localeBox, &QComboBox::currentIndexChanged, this, [this, localeBox, infoLabel](){
         SharedGui::setAppLocale(localeBox->currentData().toString());
@@ -1145,6 +1185,8 @@ auto ConfigDialog::loadProFile() -> void
                 Person::hsys_        = dec[5].toInt();
                 AspTable::mvAcc_     = dec[6].toInt();
                 PrimeTest::almuHard_ = dec[7].toBool();
+                KernelCache::capacity_ = dec[8].toInt(64);
+                ImportBase::batch_ = dec[9].toInt(10000);
                 break;
             case 1 :
             {
@@ -1242,7 +1284,8 @@ auto ConfigDialog::dumpProFile(const QString& name) -> void
     QJsonArray sideA {
         Person::name_, Person::location_, Person::utc_,
         Person::lat_, Person::lon_, Person::hsys_,
-        AspTable::mvAcc_, PrimeTest::almuHard_
+        AspTable::mvAcc_, PrimeTest::almuHard_, KernelCache::capacity_,
+        ImportBase::batch_
     };
 
     QJsonArray fontArr;
@@ -1378,6 +1421,8 @@ auto ConfigDialog::restore(int mode) -> void
         Person::hsys_ = 'P';
         AspTable::mvAcc_ = 25;
         PrimeTest::almuHard_ = true;
+        KernelCache::capacity_ = 64;
+        ImportBase::batch_ = 10000;
     }
     if ((mode & RestoreMode::SideB) != 0)
     {
@@ -91,6 +91,8 @@ private slots :
 
     void onMapViewAccChange(int value);
     void onAlmuHardChange(bool value);
+    void onCacheCapChange(int value);
+    void onImportBatchChange(int value);
 
 private :
     QString nameR_;
@@ -101,6 +103,8 @@ private :
     int     hsysR_;
     int     mvAccR_;
     bool    almuHardR_;
+    int     cacheCapR_;
+    int     importBatchR_;
 
     CanvasFont  fontSrcR_;
     CanvasColor colorSrcR_;
@@ -2,28 +2,46 @@
 #include <QMenu>
 #include <QKeyEvent>
 #include <QMessageBox>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QProgressDialog>
+#include <QtConcurrent>
+#include "mask.h"
 #include "shared.h"
 #include "Kernel/Person.h"
 #include "LineEditDialog.h"
 #include "PersonDialog.h"
+#include "PersonModel.h"
+#include "PersonImport.h"
+#include "ChartRender.h"
 #include "DataBaseDialog.h"
 #include "ui_DataBaseDialog.h"
 
 namespace napatahti {
 
-DataBaseDialog::DataBaseDialog(Person& person, AtlasDialog* atlas, QWidget* root)
+DataBaseDialog::DataBaseDialog(Person& person, const AstroBase& astroBase, const AspTable& aspTable,
+                               AtlasDialog* atlas, QWidget* root)
     : QDialog (root)
     , ui (new Ui::DataBaseDialog)
     , personDialog_ (new PersonDialog(atlas, this))
+    , atlas_ (atlas)
     , person_ (person)
-    , dbase_ (QSqlDatabase::addDatabase("QSQLITE", "DataBaseDialog"))
+    , dbase_ ("DataBaseDialog", dbaseName_)
+    , model_ (new PersonModel(dbase_, this))
+    , prefetchTimer_ (new QTimer(this))
+    , query_ (astroBase, aspTable)
+    , queryTimer_ (new QTimer(this))
+    , queryStamp_ (0)
+    , queryRange_ {0, -1}
 {
     ui->setupUi(this);
     setLocale(locale_);
 
     setWindowFlags(windowFlags() | Qt::WindowMinimizeButtonHint | Qt::WindowMaximizeButtonHint);
 
+    ui->table->setModel(model_);
     ui->table->horizontalHeader()->setVisible(true);
+    ui->table->horizontalHeader()->setSortIndicator(0, Qt::AscendingOrder);
     ui->table->setColumnWidth(0, 300);
     ui->table->setColumnWidth(1, 100);
     ui->table->setColumnWidth(2, 100);
@@ -35,9 +53,15 @@ DataBaseDialog::DataBaseDialog(Person& person, AtlasDialog* atlas, QWidget* root
     ui->table->setColumnWidth(8, 70);
     ui->table->setColumnWidth(9, 50);
 
-    dbase_.setDatabaseName(dbaseName_);
+    migrate();
     reloadTable(true);
 
+    prefetchTimer_->setSingleShot(true);
+    connect(prefetchTimer_, &QTimer::timeout, this, &DataBaseDialog::onPrefetch);
+
+    queryTimer_->setSingleShot(true);
+    connect(queryTimer_, &QTimer::timeout, this, &DataBaseDialog::onQueryStep);
+
     connect(personDialog_, &PersonDialog::personChanged, this, &DataBaseDialog::onPersonChange);
     connect(personDialog_, &PersonDialog::personInserted, this, &DataBaseDialog::onPersonInsert);
     connect(personDialog_, &PersonDialog::personUpdated, this, &DataBaseDialog::onPersonUpdate);
@@ -48,10 +72,17 @@ DataBaseDialog::DataBaseDialog(Person& person, AtlasDialog* atlas, QWidget* root
                                 this, &DataBaseDialog::onContextMenuTableList);
 
     connect(ui->selectLine, &QLineEdit::textChanged, this, &DataBaseDialog::onTextChange);
-
-    connect(ui->table, &QTableWidget::cellDoubleClicked, this, &DataBaseDialog::onApply);
-    connect(ui->table, &QTableWidget::customContextMenuRequested,
+    connect(ui->queryLine, &QLineEdit::returnPressed, this, &DataBaseDialog::onQuery);
+    connect(ui->queryLine, &QLineEdit::textChanged, this, [this](const QString& text) {
+        if (text.isEmpty())
+            resetQuery();
+    });
+
+    connect(ui->table, &QTableView::doubleClicked, this, &DataBaseDialog::onApply);
+    connect(ui->table, &QTableView::customContextMenuRequested,
                                     this, &DataBaseDialog::onContextMenuTable);
+    connect(ui->table->selectionModel(), &QItemSelectionModel::currentRowChanged,
+                                    this, &DataBaseDialog::onCurrentRowChange);
 
     connect(ui->applyButton, &QPushButton::clicked, this, &DataBaseDialog::onApply);
     connect(ui->newButton, &QPushButton::clicked, this, [this](){ execPersonDialog(false); });
@@ -68,6 +99,16 @@ DataBaseDialog::DataBaseDialog(Person& person, AtlasDialog* atlas, QWidget* root
     connect(ui->actionCut, &QAction::triggered, this, &DataBaseDialog::onCut);
     connect(ui->actionCopy, &QAction::triggered, this, &DataBaseDialog::onCopy);
     connect(ui->actionPaste, &QAction::triggered, this, &DataBaseDialog::onPaste);
+    connect(ui->actionImport, &QAction::triggered, this, &DataBaseDialog::onImport);
+    connect(ui->actionExport, &QAction::triggered, this, &DataBaseDialog::onExport);
+
+    // Paste benchmark, a shortcut only
+    auto actBench (new QAction(this));
+    actBench->setShortcut(QKeySequence("Ctrl+Shift+F12"));
+    addAction(actBench);
+
+    connect(actBench, &QAction::triggered, this, &DataBaseDialog::onPasteBench);
+    connect(ui->actionFeatures, &QAction::triggered, this, &DataBaseDialog::featureIndexToggled);
     connect(ui->currentButton, &QPushButton::clicked,
                     this, [this](){ personDialog_->modeExec(true, &person_); });
 
@@ -96,7 +137,7 @@ void DataBaseDialog::onPersonChange(const Person& person)
         if (isVisible())
             ui->table->clearSelection();
 
-        emit personChanged(0, 0);
+        emit personChanged(KernelMask::Cached, 0);
         emit personNeedSync();
         emit patchNeedSync();
     }
@@ -109,9 +150,9 @@ void DataBaseDialog::onPersonInsert(const Person& person)
 
     if (dbase_.open())
     {
-        auto query (dbase_.exec());
+        auto& query (dbase_.prepare(mask_.insert));
 
-        query.prepare(mask_.insert.arg(table_));
+        query.addBindValue(table_);
         query.addBindValue(person.name);
         query.addBindValue(person.dateTime);
         query.addBindValue(person.sex);
@@ -119,28 +160,17 @@ void DataBaseDialog::onPersonInsert(const Person& person)
         query.addBindValue(person.lat);
         query.addBindValue(person.lon);
         query.addBindValue(person.hsys);
-        query.addBindValue(person.patch);
+        query.addBindValue(person.patch.toBlob());
 
         resp = query.exec();
 
         if (resp)
         {
-            ui->table->setSortingEnabled(false);
-
-            auto row (addToTable(person));
+            model_->reload();
 
             if (dialogMode_)
-            {
-                ui->table->setCurrentItem(ui->table->item(row, 0));
-
-                for (auto i (0); i < 10; ++i)
-                    ui->table->item(row, i)->setSelected(true);
-            }
-
-            ui->table->setSortingEnabled(true);
+                selectRow(model_->findRow(person));
         }
-
-        dbase_.close();
     }
     else
         errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
@@ -151,7 +181,7 @@ void DataBaseDialog::onPersonInsert(const Person& person)
         if (resp)
             person_.table = table_;
 
-        emit personChanged(0, 0);
+        emit personChanged(KernelMask::Cached, 0);
         emit personNeedSync();
         emit patchNeedSync();
     }
@@ -162,9 +192,8 @@ void DataBaseDialog::onPersonUpdate(const QVariantMap& key, const Person& person
 {
     if (dbase_.open())
     {
-        auto query (dbase_.exec());
+        auto& query (dbase_.prepare(mask_.update));
 
-        query.prepare(mask_.update.arg(person.table));
         query.addBindValue(person.name);
         query.addBindValue(person.dateTime);
         query.addBindValue(person.sex);
@@ -172,45 +201,19 @@ void DataBaseDialog::onPersonUpdate(const QVariantMap& key, const Person& person
         query.addBindValue(person.lat);
         query.addBindValue(person.lon);
         query.addBindValue(person.hsys);
-        query.addBindValue(person.patch);
+        query.addBindValue(person.patch.toBlob());
+        query.addBindValue(person.table);
         query.addBindValue(key["name"]);
         query.addBindValue(key["dateTime"]);
         query.addBindValue(key["sex"]);
 
-        if (query.exec() && person.table == table_)
+        auto resp (query.exec());
+
+        if (resp && person.table == table_)
         {
-            auto match (ui->table->findItems(key["name"].toString(), Qt::MatchExactly));
-            for (auto i : match)
-            {
-                auto row (i->row());
-                if (key == getPersonData(row, false))
-                {
-                    ui->table->setSortingEnabled(false);
-
-                    ui->table->item(row, 0)->setText(person.name);
-                    ui->table->item(row, 1)->setText(person.dateTime.date().toString("dd.MM.yyyy"));
-                    ui->table->item(row, 1)->setData(Qt::UserRole, person.dateTime);
-                    ui->table->item(row, 2)->setText(person.dateTime.time().toString("hh:mm"));
-                    ui->table->item(row, 3)->setText(toStrUtc(person.dateTime.offsetFromUtc(), false));
-                    ui->table->item(row, 4)->setText(static_cast<QChar>(person.sex));
-                    ui->table->item(row, 4)->setData(Qt::UserRole, person.sex);
-                    ui->table->item(row, 5)->setText(toStrCrd(person.lat, true));
-                    ui->table->item(row, 5)->setData(Qt::UserRole, person.lat);
-                    ui->table->item(row, 6)->setText(toStrCrd(person.lon, false));
-                    ui->table->item(row, 6)->setData(Qt::UserRole, person.lon);
-                    ui->table->item(row, 7)->setText(person.location);
-                    ui->table->item(row, 8)->setText(static_cast<QChar>(person.hsys));
-                    ui->table->item(row, 8)->setData(Qt::UserRole, person.hsys);
-                    ui->table->item(row, 9)->setText(person.patch.isEmpty() ? "-" : "+");
-                    ui->table->item(row, 9)->setData(Qt::UserRole, person.patch);
-
-                    ui->table->setSortingEnabled(true);
-                    break;
-                }
-            }
+            model_->reload();
+            selectRow(model_->findRow(person));
         }
-
-        dbase_.close();
     }
     else
         errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
@@ -218,7 +221,7 @@ void DataBaseDialog::onPersonUpdate(const QVariantMap& key, const Person& person
     if (dialogMode_ || person_.isCurrent(key, person.table))
     {
         person_ = person;
-        emit personChanged(0, 0);
+        emit personChanged(KernelMask::Cached, 0);
         emit personNeedSync();
         emit patchNeedSync();
     }
@@ -234,28 +237,17 @@ void DataBaseDialog::onPersonDelete(const QVariantMap& data)
 
     if (dbase_.open())
     {
-        auto query(dbase_.exec());
+        auto& query (dbase_.prepare(mask_.erase));
 
-        query.prepare(mask_.erase.arg(table));
+        query.addBindValue(table);
         query.addBindValue(data["name"]);
         query.addBindValue(data["dateTime"]);
         query.addBindValue(data["sex"]);
 
-        if (query.exec() && table == table_)
-        {
-            auto match (ui->table->findItems(data["name"].toString(), Qt::MatchExactly));
-            for (auto i : match)
-            {
-                auto row (i->row());
-                if (data == getPersonData(row, true))
-                {
-                    ui->table->removeRow(row);
-                    break;
-                }
-            }
-        }
+        auto resp (query.exec());
 
-        dbase_.close();
+        if (resp && table == table_)
+            model_->reload();
     }
     else
         errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
@@ -275,11 +267,11 @@ void DataBaseDialog::onCreateTable(const QString& text)
 
     if (dbase_.open())
     {
-        auto query (dbase_.exec());
-        if (query.exec(mask_.create.arg(text)))
-            ui->tableList->addItem(text);
+        auto& query (dbase_.prepare(mask_.create));
 
-        dbase_.close();
+        query.addBindValue(text);
+        if (query.exec())
+            ui->tableList->addItem(text);
     }
     else
         errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
@@ -300,13 +292,18 @@ void DataBaseDialog::onRenameTable(const QString& text)
 
     if (dbase_.open())
     {
-        auto query (dbase_.exec());
-        if (query.exec(mask_.rename.arg(table).arg(text)))
+        // Persons follow their group by the cascading foreign key
+        auto& query (dbase_.prepare(mask_.rename));
+
+        query.addBindValue(text);
+        query.addBindValue(table);
+        if (query.exec())
         {
             selected[0]->setText(text);
             if (table_ == table)
             {
                 table_ = text;
+                model_->reload(table_);
                 emit tableChanged(table_);
             }
             if (person_.table == table)
@@ -342,10 +339,10 @@ void DataBaseDialog::onDeleteTable()
         auto resp (false);
         if (dbase_.open())
         {
-            auto query (dbase_.exec());
+            auto& query (dbase_.prepare(mask_.drop));
 
-            resp = query.exec(mask_.drop.arg(table));
-            dbase_.close();
+            query.addBindValue(table);
+            resp = query.exec();
         }
         else
             errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
@@ -377,6 +374,7 @@ void DataBaseDialog::onChangeTable(QListWidgetItem* item)
         if (table != table_)
         {
             table_ = table;
+            resetQuery();
             reloadTable();
             emit tableChanged(table_);
         }
@@ -387,24 +385,10 @@ void DataBaseDialog::onChangeTable(QListWidgetItem* item)
 void DataBaseDialog::onTextChange(const QString& text)
 {
     ui->table->clearSelection();
-    ui->table->setCurrentCell(-1, -1);
+    ui->table->setCurrentIndex({});
 
     if (!text.isEmpty())
-    {
-        auto match (ui->table->findItems(text, Qt::MatchStartsWith));
-        if (!match.isEmpty())
-        {
-            auto row (match[0]->row());
-            auto item (ui->table->item(row, 0));
-
-            ui->table->scrollToItem(item);
-            ui->table->setCurrentItem(item);
-            item->setSelected(true);
-
-            for (auto i (1); i < 10; ++i)
-                ui->table->item(row, i)->setSelected(true);
-        }
-    }
+        selectRow(model_->findText(text));
 }
 
 
@@ -415,28 +399,16 @@ void DataBaseDialog::onApply()
     if (rows.size() != 1)
         return;
 
-    auto row (*rows.begin());
-
-    Person person {
-        ui->table->item(row, 0)->text(),
-        ui->table->item(row, 1)->data(Qt::UserRole).toDateTime(),
-        ui->table->item(row, 4)->data(Qt::UserRole).toInt(),
-        ui->table->item(row, 7)->text(),
-        ui->table->item(row, 5)->data(Qt::UserRole).toInt(),
-        ui->table->item(row, 6)->data(Qt::UserRole).toInt(),
-        ui->table->item(row, 8)->data(Qt::UserRole).toInt(),
-        ui->table->item(row, 9)->data(Qt::UserRole).toString(),
-        table_
-    };
+    auto person (model_->getPerson(*rows.begin()));
 
-    if (person_ == person)
+    if (person == nullptr || person_ == *person)
     {
         close();
         return;
     }
 
-    person_ = std::move(person);
-    emit personChanged(0, 0);
+    person_ = *person;
+    emit personChanged(KernelMask::Cached, 0);
     emit personNeedSync();
     emit patchNeedSync();
     close();
@@ -450,9 +422,12 @@ void DataBaseDialog::onDelete()
     if (rows.empty())
         return;
 
+    auto first (model_->getPerson(*rows.begin()));
+    if (first == nullptr)
+        return;
+
     auto part (rows.size() == 1
-        ? ui->table->item(*rows.begin(), 0)->text() + ", " +
-          ui->table->item(*rows.begin(), 1)->data(Qt::UserRole).toDateTime().toString("dd.MM.yyyy h:mm:ss t")
+        ? first->name + ", " + first->dateTime.toString("dd.MM.yyyy h:mm:ss t")
         : tr("selected rows"));
 
     auto msgBox (new QMessageBox(
@@ -465,15 +440,13 @@ void DataBaseDialog::onDelete()
 
     if (msgBox->exec() == QMessageBox::Yes)
     {
-        auto isCurrentDeleted (false);
-        auto match (ui->table->findItems(person_.name, Qt::MatchExactly));
+        auto isCurrentDeleted (person_.table == table_ && contains(model_->findRow(person_), rows));
 
-        for (auto i : match)
-            if (person_.isCurrent(getPersonData(i->row(), true)))
-            {
-                isCurrentDeleted = contains(i->row(), rows);
-                break;
-            }
+        // Rows are collected first, the pages they live in are dropped on reload
+        std::vector<Person> erased;
+        for (auto i : rows)
+            if (auto person (model_->getPerson(i)); person != nullptr)
+                erased.push_back(*person);
 
         if (!dbase_.open())
         {
@@ -481,20 +454,22 @@ void DataBaseDialog::onDelete()
             return;
         }
 
-        auto query (dbase_.exec());
+        auto& query (dbase_.prepare(mask_.erase));
 
-        for (auto i (rows.rbegin()); i != rows.rend(); ++i)
-        {
-            query.prepare(mask_.erase.arg(table_));
-            query.addBindValue(ui->table->item(*i, 0)->text());
-            query.addBindValue(ui->table->item(*i, 1)->data(Qt::UserRole));
-            query.addBindValue(ui->table->item(*i, 4)->data(Qt::UserRole));
+        // One transaction for the whole selection, not one journal sync per row
+        dbase_.transaction();
 
-            if (query.exec())
-                ui->table->removeRow(*i);
+        for (auto& i : erased)
+        {
+            query.addBindValue(table_);
+            query.addBindValue(i.name);
+            query.addBindValue(i.dateTime);
+            query.addBindValue(i.sex);
+            query.exec();
         }
 
-        dbase_.close();
+        dbase_.commit();
+        model_->reload();
 
         if (isCurrentDeleted)
         {
@@ -516,7 +491,8 @@ void DataBaseDialog::onCopy()
     pasteMode_ = false;
 
     for (auto i : rows)
-        clipboard_.insert(getPerson(i));
+        if (auto person (getPerson(i)); person != nullptr)
+            clipboard_.insert(person);
 }
 
 
@@ -530,11 +506,25 @@ void DataBaseDialog::onCut()
     clipboard_.clear();
     pasteMode_ = true;
 
-    for (auto i (rows.rbegin()); i != rows.rend(); ++i)
+    // Cut rows stay in the table greyed out until they are pasted
+    std::vector<QVariantMap> marked;
+
+    for (auto i : rows)
     {
-        clipboard_.insert(getPerson(*i));
-        ui->table->removeRow(*i);
+        auto person (getPerson(i));
+        if (person == nullptr)
+            continue;
+
+        clipboard_.insert(person);
+        marked.push_back({
+            {"name", person->name},
+            {"dateTime", person->dateTime},
+            {"sex", person->sex},
+            {"table", person->table}
+        });
     }
+
+    model_->setMarked(std::move(marked));
 }
 
 
@@ -545,9 +535,11 @@ void DataBaseDialog::onPaste()
 
     if (dbase_.open())
     {
-        ui->table->setSortingEnabled(false);
+        auto& insert (dbase_.prepare(mask_.insert));
 
-        auto query (dbase_.exec());
+        // The whole clipboard goes in one transaction, so the journal
+        // is synced once instead of after every row
+        dbase_.transaction();
 
         for (auto i : clipboard_)
         {
@@ -559,37 +551,206 @@ void DataBaseDialog::onPaste()
                     emit personNeedSync();
                 }
 
-                query.prepare(mask_.erase.arg(i->table));
-                query.addBindValue(i->name);
-                query.addBindValue(i->dateTime);
-                query.addBindValue(i->sex);
-                query.exec();
+                auto& erase (dbase_.prepare(mask_.erase));
+                erase.addBindValue(i->table);
+                erase.addBindValue(i->name);
+                erase.addBindValue(i->dateTime);
+                erase.addBindValue(i->sex);
+                erase.exec();
             }
 
-            query.prepare(mask_.insert.arg(table_));
-            query.addBindValue(i->name);
-            query.addBindValue(i->dateTime);
-            query.addBindValue(i->sex);
-            query.addBindValue(i->location);
-            query.addBindValue(i->lat);
-            query.addBindValue(i->lon);
-            query.addBindValue(i->hsys);
-            query.addBindValue(i->patch);
-
-            if (query.exec())
-                addToTable(*i);
+            insert.addBindValue(table_);
+            insert.addBindValue(i->name);
+            insert.addBindValue(i->dateTime);
+            insert.addBindValue(i->sex);
+            insert.addBindValue(i->location);
+            insert.addBindValue(i->lat);
+            insert.addBindValue(i->lon);
+            insert.addBindValue(i->hsys);
+            insert.addBindValue(i->patch.toBlob());
+            insert.exec();
         }
 
         pasteMode_ = false;
 
-        ui->table->setSortingEnabled(true);
-        dbase_.close();
+        dbase_.commit();
+
+        model_->setMarked({});
+        model_->reload();
     }
     else
         errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
 }
 
 
+void DataBaseDialog::onPasteBench()
+{
+    // Generated persons go through onPaste into a scratch group, which is dropped afterwards
+    QString benchTable ("~bench");
+
+    if (!dbase_.open())
+    {
+        errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
+        return;
+    }
+
+    auto& create (dbase_.prepare(mask_.create));
+    create.addBindValue(benchTable);
+    create.exec();
+
+    std::vector<Person> person (benchSize_);
+    auto begin (QDateTime::currentDateTime());
+
+    for (auto i (0); i < benchSize_; ++i)
+    {
+        person[i].name = QString("Bench %1").arg(i);
+        person[i].dateTime = begin.addSecs(-60 * i);
+    }
+
+    auto clipboard (std::move(clipboard_));
+    auto pasteMode (pasteMode_);
+    auto table (table_);
+
+    clipboard_.clear();
+    for (auto& i : person)
+        clipboard_.insert(&i);
+
+    pasteMode_ = false;
+    table_ = benchTable;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    onPaste();
+
+    auto elapsed (std::max(timer.elapsed(), qint64(1)));
+
+    table_ = table;
+    pasteMode_ = pasteMode;
+    clipboard_ = std::move(clipboard);
+
+    auto& drop (dbase_.prepare(mask_.drop));
+    drop.addBindValue(benchTable);
+    if (!drop.exec())
+        errorLog("Can not drop " + benchTable + " : " + drop.lastError().text());
+
+    model_->reload();
+
+    ui->queryLabel->setText(QString("%1 : %2 rows, %3 ms, %4 rows/s")
+        .arg(tr("Paste"))
+        .arg(benchSize_)
+        .arg(elapsed)
+        .arg(1000.0 * benchSize_ / elapsed, 0, 'f', 0));
+}
+
+
+void DataBaseDialog::onImport()
+{
+    auto fileName (QFileDialog::getOpenFileName(
+        this, tr("Import"), "", tr("Birth data (*.csv *.jsonl *.ndjson *.txt);;All files (*)")));
+
+    if (fileName.isEmpty())
+        return;
+
+    auto progress (new QProgressDialog(
+        tr("Import") + ' ' + QFileInfo(fileName).fileName() + "...", tr("Cancel"), 0, 1000, this));
+
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(500);
+
+    PersonImport import (dbase_, atlas_);
+
+    auto report (import.exec(fileName, table_, [progress](double part) {
+        progress->setValue(static_cast<int>(1000 * part));
+        return !progress->wasCanceled();
+    }));
+
+    delete progress;
+    model_->reload();
+
+    auto msgBox (new QMessageBox(
+        QMessageBox::Information, tr("Import"),
+        (report.canceled ? tr("Import canceled") + "\n\n" : QString()) +
+        tr("Rows read") + " : " + QString::number(report.read) + '\n' +
+        tr("Inserted") + " : " + QString::number(report.inserted) + '\n' +
+        tr("Duplicates") + " : " + QString::number(report.duplicate) + '\n' +
+        tr("Skipped") + " : " + QString::number(report.skipped) + '\n' +
+        tr("Time") + " : " + QString::number(report.msecs / 1000.0, 'f', 1) + tr(" s") + ", " +
+        QString::number(qRound(report.rate())) + tr(" rows/s"),
+        QMessageBox::Ok, this));
+
+    msgBox->setAttribute(Qt::WA_WindowPropagation, true);
+    msgBox->setWindowIcon(QIcon(":/24x24/table.png"));
+    msgBox->exec();
+}
+
+
+void DataBaseDialog::onExport()
+{
+    auto rows (selectedRows());
+
+    if (rows.empty())
+        return;
+
+    auto fileName (QFileDialog::getSaveFileName(this, tr("Export charts"), table_, ChartRender::getFilter()));
+
+    if (fileName.isEmpty())
+        return;
+
+    // The chosen name is a prefix, every chart gets its number after it
+    QFileInfo info (fileName);
+    auto suffix (info.suffix().isEmpty() ? QString("png") : info.suffix());
+    auto width (static_cast<int>(QString::number(rows.size()).size()));
+
+    struct Job {
+        QPicture picture;
+        QString  fileName;
+        bool     saved;
+    };
+
+    auto progress (new QProgressDialog(
+        tr("Export charts") + "...", tr("Cancel"), 0, static_cast<int>(rows.size()), this));
+
+    progress->setWindowModality(Qt::WindowModal);
+    progress->setMinimumDuration(500);
+
+    ChartRender render;
+    auto row (rows.cbegin());
+    auto count (0);
+    auto saved (0);
+
+    // Charts are recorded here, the kernel is not shared, the pool only paints them
+    while (row != rows.cend() && !progress->wasCanceled())
+    {
+        std::vector<Job> job;
+
+        for (; row != rows.cend() && static_cast<int>(job.size()) < exportChunk_; ++row)
+            if (auto person (getPerson(*row)); person != nullptr)
+                job.push_back({
+                    render.record(*person, exportSize_),
+                    info.dir().filePath(QString("%1 %2.%3")
+                        .arg(info.completeBaseName()).arg(++count, width, 10, QChar('0')).arg(suffix)),
+                    false});
+
+        QtConcurrent::blockingMap(job, [](Job& i) {
+            i.saved = ChartRender::save(i.picture, i.fileName, exportSize_);
+        });
+
+        for (auto& i : job)
+            if (i.saved)
+                ++saved;
+            else
+                errorLog("can not save " + i.fileName);
+
+        progress->setValue(static_cast<int>(std::distance(rows.cbegin(), row)));
+    }
+
+    delete progress;
+
+    ui->queryLabel->setText(tr("Exported : %1 of %2").arg(saved).arg(rows.size()));
+}
+
+
 void DataBaseDialog::onContextMenuTableList(const QPoint& pos)
 {
     auto menu (new QMenu(this));
@@ -600,8 +761,13 @@ void DataBaseDialog::onContextMenuTableList(const QPoint& pos)
     {
         menu->addAction(ui->actionRenameTable);
         menu->addAction(ui->actionDeleteTable);
+        menu->addAction(ui->actionImport);
     }
 
+    ui->actionFeatures->setChecked(dbase_.open() && dbase_.hasTable("feature_state"));
+
+    menu->addSeparator();
+    menu->addAction(ui->actionFeatures);
     menu->exec(ui->tableList->mapToGlobal(pos));
 }
 
@@ -610,7 +776,7 @@ void DataBaseDialog::onContextMenuTable(QPoint pos)
 {
     auto menu (new QMenu(this));
 
-    if (ui->table->itemAt(pos) != nullptr)
+    if (ui->table->indexAt(pos).isValid())
     {
         if (selectedRows().size() > 1)
         {
@@ -628,6 +794,7 @@ void DataBaseDialog::onContextMenuTable(QPoint pos)
         menu->addAction(ui->actionCopy);
         if (!clipboard_.empty())
             menu->addAction(ui->actionPaste);
+        menu->addAction(ui->actionExport);
     }
     else
     {
@@ -635,12 +802,194 @@ void DataBaseDialog::onContextMenuTable(QPoint pos)
         if (!clipboard_.empty())
             menu->addAction(ui->actionPaste);
     }
+    menu->addAction(ui->actionImport);
 
     pos.ry() += ui->table->horizontalHeader()->height();
     menu->exec(ui->table->mapToGlobal(pos));
 }
 
 
+void DataBaseDialog::onCurrentRowChange(const QModelIndex& current, const QModelIndex& previous)
+{
+    prefetchTimer_->stop();
+    prefetch_.clear();
+
+    auto row (current.row());
+    auto prevRow (previous.row());
+
+    if (row < 0)
+        return;
+
+    // A single step keeps its direction, so the rows ahead go first.
+    // Any other move is a jump and the old queue is simply dropped.
+    auto step (row - prevRow);
+    auto dir (step == 1 || step == -1 ? step : 0);
+    auto count (model_->rowCount());
+
+    prefetch_.push_back(row);
+
+    for (auto i (1); i <= prefetchDepth_; ++i)
+    {
+        if (dir != 0)
+        {
+            if (auto next (row + dir * i); next >= 0 && next < count)
+                prefetch_.push_back(next);
+        }
+        else
+        {
+            if (row + i < count)
+                prefetch_.push_back(row + i);
+            if (row - i >= 0)
+                prefetch_.push_back(row - i);
+        }
+    }
+
+    if (dir != 0 && row - dir >= 0 && row - dir < count)
+        prefetch_.push_back(row - dir);
+
+    prefetchTimer_->start(prefetchDelay_);
+}
+
+
+void DataBaseDialog::onPrefetch()
+{
+    if (prefetch_.empty() || !isVisible())
+    {
+        prefetch_.clear();
+        return;
+    }
+
+    auto row (prefetch_.front());
+    prefetch_.pop_front();
+
+    if (auto person (model_->getPerson(row)); person != nullptr)
+        emit personPrefetch(*person);
+
+    // One chart per tick, so input events are handled in between
+    if (!prefetch_.empty())
+        prefetchTimer_->start(0);
+}
+
+
+void DataBaseDialog::onQuery()
+{
+    queryTimer_->stop();
+
+    auto text (ui->queryLine->text().trimmed());
+
+    if (text.isEmpty())
+    {
+        resetQuery();
+        return;
+    }
+
+    if (!dbase_.open())
+    {
+        errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
+        return;
+    }
+
+    // Features are sought for the settings the chart index was filled for last
+    auto isIndexed (dbase_.hasTable("feature_stamp"));
+    queryStamp_ = 0;
+
+    if (isIndexed)
+    {
+        auto& stamp (dbase_.prepare(mask_.stamp));
+        if (stamp.exec() && stamp.next())
+            queryStamp_ = stamp.value(0).toLongLong();
+        stamp.finish();
+    }
+
+    if (!query_.compile(text, queryStamp_))
+    {
+        ui->queryLabel->setText(query_.getError());
+        return;
+    }
+
+    if (query_.needFeatures() && !isIndexed)
+    {
+        ui->queryLabel->setText(tr("Chart index is off"));
+        return;
+    }
+
+    auto query (dbase_.exec());
+
+    if (!query.exec(mask_.matchTable) || !query.exec(mask_.matchClear))
+    {
+        errorLog("Can not run the query : " + query.lastError().text());
+        return;
+    }
+
+    auto& range (dbase_.prepare(mask_.matchRange));
+    range.addBindValue(table_);
+
+    queryRange_ = {0, -1};
+    if (range.exec() && range.next() && !range.value(0).isNull())
+        queryRange_ = {range.value(0).toLongLong(), range.value(1).toLongLong()};
+
+    range.finish();
+
+    model_->setFiltered(true);
+    model_->reload();
+
+    queryClock_.start();
+    queryTimer_->start(0);
+}
+
+
+void DataBaseDialog::onQueryStep()
+{
+    auto last (std::min(queryRange_[0] + queryStep_ - 1, queryRange_[1]));
+
+    if (queryRange_[0] <= last)
+    {
+        auto& query (dbase_.prepare(mask_.matchStep.arg(query_.getWhere())));
+        query.addBindValue(table_);
+        query.addBindValue(queryRange_[0]);
+        query.addBindValue(last);
+
+        for (auto& i : query_.getBind())
+            query.addBindValue(i);
+
+        if (!query.exec())
+        {
+            ui->queryLabel->setText(query.lastError().text());
+            return;
+        }
+    }
+
+    queryRange_[0] = last + 1;
+
+    // The list grows slice by slice while the rest is scanned
+    model_->reload();
+
+    if (queryRange_[0] <= queryRange_[1])
+    {
+        ui->queryLabel->setText(tr("%1 found...").arg(model_->rowCount()));
+        queryTimer_->start(0);
+        return;
+    }
+
+    auto status (tr("%1 found, %2 ms").arg(model_->rowCount()).arg(queryClock_.elapsed()));
+
+    // Persons the index has not reached yet can not match
+    if (query_.needFeatures())
+    {
+        auto& count (dbase_.prepare(mask_.unindexed));
+        count.addBindValue(table_);
+        count.addBindValue(queryStamp_);
+
+        if (count.exec() && count.next() && count.value(0).toInt() > 0)
+            status += ", " + tr("%1 not indexed").arg(count.value(0).toInt());
+
+        count.finish();
+    }
+
+    ui->queryLabel->setText(status);
+}
+
+
 auto DataBaseDialog::showEvent(QShowEvent*) -> void
 {
     ui->table->scrollToTop();
@@ -650,26 +999,17 @@ auto DataBaseDialog::showEvent(QShowEvent*) -> void
     else
     {
         ui->table->clearSelection();
-        ui->table->setCurrentCell(-1, -1);
+        ui->table->setCurrentIndex({});
     }
 
     ui->selectLine->setFocus();
 
-    auto match (ui->table->findItems(person_.name, Qt::MatchExactly));
-    for (auto i : match)
-    {
-        auto row (i->row());
-        if (person_.isCurrent(getPersonData(row, true)))
-        {
-            ui->table->setCurrentItem(i);
-            ui->table->scrollToItem(i);
+    if (person_.table == table_)
+        selectRow(model_->findRow(person_));
 
-            for (auto i (1); i < 10; ++i)
-                ui->table->item(row, i)->setSelected(true);
-
-            break;
-        }
-    }
+    // A query cut short by hiding goes on from the slice it stopped at
+    if (model_->isFiltered() && queryRange_[0] <= queryRange_[1])
+        queryTimer_->start(0);
 
     auto geo (geometry());
     auto end (screen()->geometry().bottomRight());
@@ -686,6 +1026,14 @@ auto DataBaseDialog::showEvent(QShowEvent*) -> void
 }
 
 
+auto DataBaseDialog::hideEvent(QHideEvent*) -> void
+{
+    prefetchTimer_->stop();
+    prefetch_.clear();
+    queryTimer_->stop();
+}
+
+
 auto DataBaseDialog::keyPressEvent(QKeyEvent* event) -> void
 {
     switch (event->key()) {
@@ -741,6 +1089,10 @@ auto DataBaseDialog::keyPressEvent(QKeyEvent* event) -> void
                 execPersonDialog(true);
         }
         break;
+    case Qt::Key_I :
+        if ((event->modifiers() & Qt::ControlModifier) != 0)
+            onImport();
+        break;
     case Qt::Key_B :
         if ((event->modifiers() & Qt::ControlModifier) != 0)
             personDialog_->modeExec(true, &person_);
@@ -755,6 +1107,73 @@ auto DataBaseDialog::keyPressEvent(QKeyEvent* event) -> void
 }
 
 
+auto DataBaseDialog::migrate() -> void
+{
+    if (!dbase_.open())
+    {
+        errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
+        return;
+    }
+
+    if (dbase_.getVersion() >= version_)
+        return;
+
+    // Version 0 kept every group in a table of its own with untyped
+    // columns, they are moved into one typed table keyed by the group
+    auto isReserved = [](const QString& table) { return table == "groups" || table == "persons"; };
+
+    QStringList legacy;
+
+    auto query (dbase_.exec(mask_.legacy));
+    while (query.next())
+        legacy.push_back(query.value(0).toString());
+    query.finish();
+
+    dbase_.forget();
+    dbase_.transaction();
+
+    auto resp (true);
+
+    for (auto& i : legacy)
+    {
+        dbase_.dropIndex(i);
+
+        // A group named as one of the new tables steps aside first
+        if (isReserved(i))
+            resp = resp && query.exec(mask_.renameLegacy.arg(i));
+    }
+
+    for (auto& i : mask_.schema)
+        resp = resp && query.exec(i);
+
+    for (auto& i : legacy)
+    {
+        if (!resp)
+            break;
+
+        auto source (isReserved(i) ? i + "_v0" : i);
+
+        query.prepare(mask_.create);
+        query.addBindValue(i);
+        resp = query.exec();
+
+        query.prepare(mask_.move.arg(source));
+        query.addBindValue(i);
+        resp = resp && query.exec();
+
+        resp = resp && query.exec(mask_.dropLegacy.arg(source));
+    }
+
+    resp = resp && dbase_.setVersion(version_);
+
+    if (resp && dbase_.commit())
+        return;
+
+    errorLog("Can not migrate " + dbaseName_ + " : " + query.lastError().text());
+    dbase_.rollback();
+}
+
+
 auto DataBaseDialog::reloadTable(bool mode) -> void
 {
     if (dbase_.open())
@@ -777,12 +1196,16 @@ auto DataBaseDialog::reloadTable(bool mode) -> void
                 ++count;
             }
 
+            query.finish();
+
             if (count == 0 || ui->tableList->currentRow() < 0)
             {
                 if (count == 0 || !tableReg_.match(table_).hasMatch())
                     table_ = tableBack_;
 
-                dbase_.exec(mask_.create.arg(table_));
+                auto& create (dbase_.prepare(mask_.create));
+                create.addBindValue(table_);
+                create.exec();
 
                 auto newItem (new QListWidgetItem(table_));
                 ui->tableList->addItem(newItem);
@@ -791,77 +1214,25 @@ auto DataBaseDialog::reloadTable(bool mode) -> void
                 emit tableChanged(table_);
             }
         }
-
-        if (ui->table->rowCount() > 0)
-        {
-            ui->table->clearContents();
-            ui->table->setRowCount(0);
-        }
-
-        query.exec(mask_.select.arg(table_));
-        ui->table->setSortingEnabled(false);
-
-        while (query.next())
-            addToTable(Person(query));
-
-        ui->table->setSortingEnabled(true);
-        dbase_.close();
     }
     else
         errorLog("Can not open " + dbaseName_ + " : " + dbase_.lastError().text());
+
+    // Only the row count is read here, pages are fetched as they are shown
+    model_->reload(table_);
 }
 
 
-auto DataBaseDialog::addToTable(const Person& person) -> int
+auto DataBaseDialog::resetQuery() -> void
 {
-    auto row (ui->table->rowCount());
-    ui->table->setRowCount(row + 1);
-
-    auto newItem (new QTableWidgetItem(person.name));
-    ui->table->setItem(row, 0, newItem);
-
-    newItem = new QTableWidgetItem(person.dateTime.date().toString("dd.MM.yyyy"));
-    newItem->setData(Qt::UserRole, person.dateTime);
-    newItem->setTextAlignment(Qt::AlignCenter);
-    ui->table->setItem(row, 1, newItem);
-
-    newItem = new QTableWidgetItem(person.dateTime.time().toString("hh:mm"));
-    newItem->setTextAlignment(Qt::AlignCenter);
-    ui->table->setItem(row, 2, newItem);
-
-    newItem = new QTableWidgetItem(toStrUtc(person.dateTime.offsetFromUtc(), false));
-    newItem->setTextAlignment(Qt::AlignCenter);
-    ui->table->setItem(row, 3, newItem);
-
-    newItem = new QTableWidgetItem(static_cast<QChar>(person.sex));
-    newItem->setData(Qt::UserRole, person.sex);
-    newItem->setTextAlignment(Qt::AlignCenter);
-    ui->table->setItem(row, 4, newItem);
-
-    newItem = new QTableWidgetItem(toStrCrd(person.lat, true));
-    newItem->setData(Qt::UserRole, person.lat);
-    newItem->setTextAlignment(Qt::AlignCenter);
-    ui->table->setItem(row, 5, newItem);
-
-    newItem = new QTableWidgetItem(toStrCrd(person.lon, false));
-    newItem->setData(Qt::UserRole, person.lon);
-    newItem->setTextAlignment(Qt::AlignCenter);
-    ui->table->setItem(row, 6, newItem);
-
-    newItem = new QTableWidgetItem(person.location);
-    ui->table->setItem(row, 7, newItem);
+    queryTimer_->stop();
+    ui->queryLabel->clear();
 
-    newItem = new QTableWidgetItem(static_cast<QChar>(person.hsys));
-    newItem->setData(Qt::UserRole, person.hsys);
-    newItem->setTextAlignment(Qt::AlignCenter);
-    ui->table->setItem(row, 8, newItem);
-
-    newItem = new QTableWidgetItem(person.patch.isEmpty() ? "-" : "+");
-    newItem->setData(Qt::UserRole, person.patch);
-    newItem->setTextAlignment(Qt::AlignCenter);
-    ui->table->setItem(row, 9, newItem);
+    if (!model_->isFiltered())
+        return;
 
-    return row;
+    model_->setFiltered(false);
+    model_->reload();
 }
 
 
@@ -869,9 +1240,8 @@ auto DataBaseDialog::selectedRows() const -> std::set<int>
 {
     std::set<int> res;
 
-    for (auto& i : ui->table->selectedRanges())
-        for (auto j (i.topRow()); j <= i.bottomRow(); ++j)
-            res.insert(j);
+    for (auto& i : ui->table->selectionModel()->selectedRows())
+        res.insert(i.row());
 
     return res;
 }
@@ -923,34 +1293,20 @@ auto DataBaseDialog::execPersonDialog(bool mode) -> void
 auto DataBaseDialog::getPerson(int row) const -> Person*
 {
     if (row < 0)
-        row = ui->table->currentRow();
-
-    return new Person {
-        ui->table->item(row, 0)->text(),
-        ui->table->item(row, 1)->data(Qt::UserRole).toDateTime(),
-        ui->table->item(row, 4)->data(Qt::UserRole).toInt(),
-        ui->table->item(row, 7)->text(),
-        ui->table->item(row, 5)->data(Qt::UserRole).toInt(),
-        ui->table->item(row, 6)->data(Qt::UserRole).toInt(),
-        ui->table->item(row, 8)->data(Qt::UserRole).toInt(),
-        ui->table->item(row, 9)->data(Qt::UserRole).toString(),
-        table_
-    };
+        row = ui->table->currentIndex().row();
+
+    auto person (model_->getPerson(row));
+    return person != nullptr ? new Person(*person) : nullptr;
 }
 
 
-auto DataBaseDialog::getPersonData(int row, bool table) -> QVariantMap
+auto DataBaseDialog::selectRow(int row) -> void
 {
-    QVariantMap data {
-        {"name", ui->table->item(row, 0)->text()},
-        {"dateTime", ui->table->item(row, 1)->data(Qt::UserRole)},
-        {"sex", ui->table->item(row, 4)->data(Qt::UserRole)}
-    };
-
-    if (table)
-        data["table"] = table_;
+    if (row < 0)
+        return;
 
-    return data;
+    ui->table->scrollTo(model_->index(row, 0));
+    ui->table->selectRow(row);
 }
 
 } // namespace napatahti
@@ -2,10 +2,16 @@
 #define DATABASEDIALOG_H
 
 #include <set>
-#include <QSqlDatabase>
+#include <array>
+#include <deque>
 #include <QDialog>
 #include <QListWidgetItem>
+#include <QModelIndex>
+#include <QTimer>
+#include <QElapsedTimer>
 #include "SharedGui.h"
+#include "SqlConnection.h"
+#include "PersonQuery.h"
 
 namespace Ui {
 class DataBaseDialog;
@@ -14,8 +20,11 @@ class DataBaseDialog;
 namespace napatahti {
 
 class Person;
+class AstroBase;
+class AspTable;
 class AtlasDialog;
 class PersonDialog;
+class PersonModel;
 
 
 class DataBaseDialog : public QDialog, protected SharedGui
@@ -23,17 +32,21 @@ class DataBaseDialog : public QDialog, protected SharedGui
     Q_OBJECT
 
 public :
-    explicit DataBaseDialog(Person& person, AtlasDialog* atlas, QWidget* root=nullptr);
+    explicit DataBaseDialog(Person& person, const AstroBase& astroBase, const AspTable& aspTable,
+                            AtlasDialog* atlas, QWidget* root=nullptr);
     ~DataBaseDialog();
 
     static const auto& getTableName() { return table_; }
     static auto setTableName(const QString& name) { table_ = name; }
+    static const auto& getDbaseName() { return dbaseName_; }
 
 signals :
     void personChanged(int kMask, int cMask);
+    void personPrefetch(const Person& person);
     void personNeedSync();
     void patchNeedSync();
     void tableChanged(const QString& table);
+    void featureIndexToggled(bool enabled);
 
 public slots :
     void onPersonChange(const Person& person);
@@ -43,33 +56,71 @@ public slots :
 
 public :
     struct SqlMask {
-        QString tables {"SELECT name FROM sqlite_master WHERE type='table';"};
-        QString create {"CREATE TABLE %1 ("
-                             "name BLOB, dateTime BLOB, sex BLOB, "
-                             "location BLOB, lat BLOB, lon BLOB, "
-                             "hsys BLOB, patch BLOB, "
-                             "PRIMARY KEY (name, dateTime, sex));"};
-        QString rename {"ALTER TABLE %1 RENAME TO %2;"};
-        QString drop {"DROP TABLE %1;"};
-        QString select {"SELECT * FROM %1 ORDER BY name ASC;"};
-        QString insert {"INSERT INTO %1 (name, dateTime, sex, location, lat, lon, hsys, patch) "
-                        "VALUES (?, ?, ?, ?, ?, ?, ?, ?);"};
-        QString update {"UPDATE %1 SET name=?, dateTime=?, sex=?, location=?, lat=?, lon=?, hsys=?, patch=? "
-                        "WHERE name=? AND dateTime=? AND sex=?;"};
-        QString erase {"DELETE FROM %1 WHERE name=? AND dateTime=? AND sex=?"};
+        QStringList schema {
+            "CREATE TABLE IF NOT EXISTS groups (name TEXT PRIMARY KEY NOT NULL);",
+            "CREATE TABLE IF NOT EXISTS persons ("
+                "id INTEGER PRIMARY KEY, "
+                "groupName TEXT NOT NULL REFERENCES groups (name) ON UPDATE CASCADE ON DELETE CASCADE, "
+                "name TEXT NOT NULL, dateTime TEXT NOT NULL, sex INTEGER NOT NULL, "
+                "location TEXT NOT NULL, lat INTEGER NOT NULL, lon INTEGER NOT NULL, "
+                "hsys INTEGER NOT NULL, patch BLOB, "
+                "UNIQUE (groupName, name, dateTime, sex));",
+            "CREATE INDEX IF NOT EXISTS persons_date ON persons (groupName, dateTime);",
+            "CREATE INDEX IF NOT EXISTS persons_location ON persons (groupName, location);"};
+        QString legacy {"SELECT name FROM sqlite_master WHERE type='table' "
+                            "AND name NOT LIKE 'sqlite\\_%' ESCAPE '\\' "
+                            "AND name NOT GLOB '*_fts' AND name NOT GLOB '*_fts_*';"};
+        QString move {"INSERT OR IGNORE INTO persons "
+                          "(groupName, name, dateTime, sex, location, lat, lon, hsys, patch) "
+                          "SELECT ?, CAST(name AS TEXT), CAST(dateTime AS TEXT), CAST(sex AS INTEGER), "
+                          "ifnull(CAST(location AS TEXT), ''), CAST(lat AS INTEGER), CAST(lon AS INTEGER), "
+                          "CAST(hsys AS INTEGER), patch FROM %1;"};
+        QString renameLegacy {"ALTER TABLE %1 RENAME TO %1_v0;"};
+        QString dropLegacy {"DROP TABLE %1;"};
+
+        QString tables {"SELECT name FROM groups ORDER BY rowid;"};
+        QString create {"INSERT INTO groups (name) VALUES (?);"};
+        QString rename {"UPDATE groups SET name=? WHERE name=?;"};
+        QString drop {"DELETE FROM groups WHERE name=?;"};
+        QString insert {"INSERT INTO persons (groupName, name, dateTime, sex, location, lat, lon, hsys, patch) "
+                        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);"};
+        QString update {"UPDATE persons SET name=?, dateTime=?, sex=?, location=?, "
+                        "lat=?, lon=?, hsys=?, patch=? "
+                        "WHERE groupName=? AND name=? AND dateTime=? AND sex=?;"};
+        QString erase {"DELETE FROM persons WHERE groupName=? AND name=? AND dateTime=? AND sex=?;"};
+
+        QString matchTable {"CREATE TEMP TABLE IF NOT EXISTS person_match (id INTEGER PRIMARY KEY);"};
+        QString matchClear {"DELETE FROM temp.person_match;"};
+        QString matchRange {"SELECT min(id), max(id) FROM persons WHERE groupName=?;"};
+        QString matchStep {"INSERT INTO temp.person_match SELECT p.id FROM persons p "
+                           "WHERE p.groupName=? AND p.id BETWEEN ? AND ? AND (%1);"};
+        QString stamp {"SELECT stamp FROM feature_stamp ORDER BY used DESC LIMIT 1;"};
+        QString unindexed {"SELECT COUNT(*) FROM persons p WHERE p.groupName=? AND NOT EXISTS ("
+                               "SELECT 1 FROM feature_state s WHERE s.person=p.id AND s.stamp=?);"};
     };
 
 private :
     Ui::DataBaseDialog* ui;
     PersonDialog* personDialog_;
+    AtlasDialog* atlas_;
 
     bool dialogMode_ {true};
     bool pasteMode_;
 
     Person& person_;
-    QSqlDatabase dbase_;
+    SqlConnection dbase_;
+    PersonModel* model_;
     std::set<Person*> clipboard_;
 
+    QTimer* prefetchTimer_;
+    std::deque<int> prefetch_;
+
+    PersonQuery   query_;
+    QTimer*       queryTimer_;
+    QElapsedTimer queryClock_;
+    qint64        queryStamp_;
+    std::array<qint64, 2> queryRange_;
+
     static QString table_;
 
     static const SqlMask mask_;
@@ -77,6 +128,14 @@ private :
     static const QString tableBack_;
     static const QRegularExpression tableReg_;
 
+    static constexpr int version_ {1};
+    static constexpr int prefetchDepth_ {3};
+    static constexpr int prefetchDelay_ {150};
+    static constexpr int queryStep_ {65536};
+    static constexpr int benchSize_ {10000};
+    static constexpr int exportChunk_ {64};
+    static constexpr QSize exportSize_ {1600, 1200};
+
 private slots :
     void onCreateTable(const QString& text);
     void onRenameTable(const QString& text);
@@ -88,21 +147,30 @@ private slots :
     void onCopy();
     void onCut();
     void onPaste();
+    void onPasteBench();
+    void onImport();
+    void onExport();
     void onContextMenuTableList(const QPoint& pos);
     void onContextMenuTable(QPoint pos);
+    void onCurrentRowChange(const QModelIndex& current, const QModelIndex& previous);
+    void onPrefetch();
+    void onQuery();
+    void onQueryStep();
 
 private :
     auto showEvent(QShowEvent*) -> void;
+    auto hideEvent(QHideEvent*) -> void;
     auto keyPressEvent(QKeyEvent* event) -> void;
 
     auto reloadTable(bool mode=false) -> void;
+    auto resetQuery() -> void;
+    auto migrate() -> void;
     auto execTableDialog(bool mode) -> void;
 
-    auto addToTable(const Person& person) -> int;
+    auto selectRow(int row) -> void;
     auto selectedRows() const -> std::set<int>;
     auto execPersonDialog(bool mode) -> void;
     auto getPerson(int row=-1) const -> Person*;
-    auto getPersonData(int row, bool table) -> QVariantMap;
 };
 
 } // namespace napatahti
@@ -0,0 +1,252 @@
+#include <QDateTime>
+#include "shared.h"
+#include "Canvas.h"
+#include "MainWindow.h"
+#include "DataBaseDialog.h"
+#include "FeatureIndex.h"
+
+namespace napatahti {
+
+FeatureIndex::FeatureIndex(Kernel& kernel, QObject* root)
+    : QObject (root)
+    , kernel_ (kernel)
+    , dbase_ ("FeatureIndex", DataBaseDialog::getDbaseName())
+    , timer_ (new QTimer(this))
+    , stamp_ (0)
+    , version_ (NONE)
+    , lastId_ (0)
+    , isIdle_ (false)
+{
+    connect(timer_, &QTimer::timeout, this, &FeatureIndex::onStep);
+
+    // The first step finds out whether the index was enabled before
+    timer_->start(pollDelay_);
+}
+
+
+auto FeatureIndex::isEnabled() -> bool
+{
+    return dbase_.open() && dbase_.hasTable("feature_state");
+}
+
+
+void FeatureIndex::onEnable(bool enabled)
+{
+    if (!dbase_.open())
+    {
+        errorLog("Can not open " + dbase_.getName() + " : " + dbase_.lastError().text());
+        return;
+    }
+
+    dbase_.forget();
+
+    QSqlQuery query (dbase_.exec());
+    auto& schema (enabled ? mask_.schema : mask_.drop);
+
+    dbase_.transaction();
+
+    for (auto& i : schema)
+        if (!query.exec(i))
+        {
+            errorLog("Can not " + QString(enabled ? "create" : "drop") +
+                     " the chart index : " + query.lastError().text());
+            dbase_.rollback();
+            return;
+        }
+
+    dbase_.commit();
+
+    stamp_ = 0;
+    lastId_ = 0;
+    isIdle_ = false;
+
+    if (enabled)
+        timer_->start(0);
+    else
+        timer_->stop();
+}
+
+
+void FeatureIndex::onStep()
+{
+    if (!isEnabled())
+    {
+        timer_->stop();
+        return;
+    }
+
+    auto space (Canvas::getPlanetSpace());
+    auto viewKey (MainWindow::getTrigger().aspCfgClassOnly);
+    auto stamp (kernel_.getFeatureStamp(space, viewKey));
+    auto version (dataVersion());
+
+    // Nothing was written by the other connections and no setting has changed
+    if (isIdle_ && stamp == stamp_ && version == version_)
+        return;
+
+    if (stamp != stamp_ && !useStamp(stamp))
+    {
+        timer_->stop();
+        return;
+    }
+
+    // The scan resumes after the last stored person, a change starts it over
+    if (stamp != stamp_ || version != version_)
+        lastId_ = 0;
+
+    stamp_ = stamp;
+    version_ = version;
+
+    std::vector<qint64> id;
+    std::vector<Person> person;
+
+    auto& query (dbase_.prepare(mask_.stale));
+    query.addBindValue(stamp_);
+    query.addBindValue(lastId_);
+    query.addBindValue(stepSize_);
+
+    if (query.exec())
+        while (query.next())
+        {
+            id.push_back(query.value("id").toLongLong());
+            person.emplace_back(query);
+        }
+    else
+        errorLog("Can not fetch persons : " + query.lastError().text());
+
+    query.finish();
+
+    // A slice at a time from the event loop, the kernel is not shared between threads
+    isIdle_ = id.empty();
+    timer_->start(isIdle_ ? pollDelay_ : 0);
+
+    if (isIdle_)
+        return;
+
+    if (store(id, kernel_.computeFeatures(person, space, viewKey)))
+        lastId_ = id.back();
+    else
+        timer_->start(pollDelay_);
+}
+
+
+auto FeatureIndex::useStamp(qint64 stamp) -> bool
+{
+    dbase_.transaction();
+
+    auto& query (dbase_.prepare(mask_.stamp));
+    query.addBindValue(stamp);
+    query.addBindValue(AspPage::getTitle());
+    query.addBindValue(QDateTime::currentSecsSinceEpoch());
+
+    // Recent settings keep their features, switching back costs nothing
+    auto& prune (dbase_.prepare(mask_.prune));
+    prune.addBindValue(stampCap_);
+
+    if (!query.exec())
+        errorLog("Can not update the chart index : " + query.lastError().text());
+    else if (!prune.exec())
+        errorLog("Can not update the chart index : " + prune.lastError().text());
+    else
+        return dbase_.commit();
+
+    dbase_.rollback();
+
+    return false;
+}
+
+
+auto FeatureIndex::store(const std::vector<qint64>& id, const std::vector<ChartFeatures>& feature) -> bool
+{
+    auto& state (dbase_.prepare(mask_.state));
+    auto& body (dbase_.prepare(mask_.body));
+    auto& aspect (dbase_.prepare(mask_.aspect));
+    auto& config (dbase_.prepare(mask_.config));
+    auto& core (dbase_.prepare(mask_.core));
+
+    auto resp (true);
+    auto bind ([this](QSqlQuery& query, qint64 person) {
+        query.addBindValue(person);
+        query.addBindValue(stamp_);
+    });
+    auto exec ([&resp](QSqlQuery& query) {
+        // Run even after a failure, it resets the bindings for the next row
+        if (!query.exec() && resp)
+        {
+            errorLog("Can not store chart features : " + query.lastError().text());
+            resp = false;
+        }
+    });
+
+    dbase_.transaction();
+
+    for (std::size_t i (0); resp && i < id.size(); ++i)
+    {
+        bind(state, id[i]);
+        exec(state);
+
+        for (auto& j : feature[i].body)
+        {
+            bind(body, id[i]);
+            body.addBindValue(j.key);
+            body.addBindValue(j.crd);
+            body.addBindValue(j.sign);
+            body.addBindValue(j.house);
+            exec(body);
+        }
+
+        for (auto& j : feature[i].aspect)
+        {
+            bind(aspect, id[i]);
+            aspect.addBindValue(j.less);
+            aspect.addBindValue(j.more);
+            aspect.addBindValue(j.asp);
+            aspect.addBindValue(j.orb);
+            aspect.addBindValue(j.acc);
+            exec(aspect);
+        }
+
+        // Members are fenced by commas, so LIKE '%,4,%' finds a body in the figure
+        for (auto& j : feature[i].config)
+        {
+            QStringList member;
+            for (auto k : j.member)
+                member.push_back(QString::number(k));
+
+            bind(config, id[i]);
+            config.addBindValue(j.type);
+            config.addBindValue(',' + member.join(',') + ',');
+            exec(config);
+        }
+
+        for (auto& j : feature[i].core)
+        {
+            bind(core, id[i]);
+            core.addBindValue(j.method);
+            core.addBindValue(j.view);
+            core.addBindValue(QString(j.type));
+            core.addBindValue(j.total);
+            exec(core);
+        }
+    }
+
+    if (resp)
+        return dbase_.commit();
+
+    dbase_.rollback();
+
+    return false;
+}
+
+
+auto FeatureIndex::dataVersion() -> qint64
+{
+    // Changes when another connection commits, own writes leave it alone
+    auto& query (dbase_.prepare(mask_.version));
+    auto version (query.exec() && query.next() ? query.value(0).toLongLong() : NONE);
+    query.finish();
+
+    return version;
+}
+
+} // namespace napatahti
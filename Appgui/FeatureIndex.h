@@ -0,0 +1,117 @@
+#ifndef FEATUREINDEX_H
+#define FEATUREINDEX_H
+
+#include <QObject>
+#include <QTimer>
+#include "Kernel/Kernel.h"
+#include "SharedGui.h"
+#include "SqlConnection.h"
+
+namespace napatahti {
+
+class FeatureIndex : public QObject, protected SharedGui
+{
+    Q_OBJECT
+
+public :
+    explicit FeatureIndex(Kernel& kernel, QObject* root=nullptr);
+
+    auto isEnabled() -> bool;
+
+public slots :
+    void onEnable(bool enabled);
+
+public :
+    struct SqlMask {
+        QStringList schema {
+            "CREATE TABLE IF NOT EXISTS feature_stamp ("
+                "stamp INTEGER PRIMARY KEY, page TEXT NOT NULL, used INTEGER NOT NULL);",
+            "CREATE TABLE IF NOT EXISTS feature_state ("
+                "person INTEGER NOT NULL REFERENCES persons (id) ON DELETE CASCADE, "
+                "stamp INTEGER NOT NULL REFERENCES feature_stamp (stamp) ON DELETE CASCADE, "
+                "PRIMARY KEY (person, stamp)) WITHOUT ROWID;",
+            "CREATE INDEX IF NOT EXISTS feature_state_stamp ON feature_state (stamp);",
+            "CREATE TABLE IF NOT EXISTS feature_body ("
+                "person INTEGER NOT NULL, stamp INTEGER NOT NULL, body INTEGER NOT NULL, "
+                "crd REAL NOT NULL, sign INTEGER NOT NULL, house INTEGER NOT NULL, "
+                "PRIMARY KEY (person, stamp, body), FOREIGN KEY (person, stamp) "
+                "REFERENCES feature_state (person, stamp) ON DELETE CASCADE) WITHOUT ROWID;",
+            "CREATE INDEX IF NOT EXISTS feature_body_sign ON feature_body (stamp, body, sign);",
+            "CREATE INDEX IF NOT EXISTS feature_body_house ON feature_body (stamp, body, house);",
+            "CREATE TABLE IF NOT EXISTS feature_aspect ("
+                "person INTEGER NOT NULL, stamp INTEGER NOT NULL, bodyA INTEGER NOT NULL, "
+                "bodyB INTEGER NOT NULL, asp REAL NOT NULL, orb REAL NOT NULL, acc INTEGER NOT NULL, "
+                "PRIMARY KEY (person, stamp, bodyA, bodyB), FOREIGN KEY (person, stamp) "
+                "REFERENCES feature_state (person, stamp) ON DELETE CASCADE) WITHOUT ROWID;",
+            "CREATE INDEX IF NOT EXISTS feature_aspect_pair ON feature_aspect (stamp, bodyA, bodyB, asp);",
+            "CREATE TABLE IF NOT EXISTS feature_config ("
+                "person INTEGER NOT NULL, stamp INTEGER NOT NULL, config INTEGER NOT NULL, "
+                "member TEXT NOT NULL, FOREIGN KEY (person, stamp) "
+                "REFERENCES feature_state (person, stamp) ON DELETE CASCADE);",
+            "CREATE INDEX IF NOT EXISTS feature_config_person ON feature_config (person, stamp);",
+            "CREATE INDEX IF NOT EXISTS feature_config_type ON feature_config (stamp, config);",
+            "CREATE TABLE IF NOT EXISTS feature_core ("
+                "person INTEGER NOT NULL, stamp INTEGER NOT NULL, method INTEGER NOT NULL, "
+                "view INTEGER NOT NULL, type TEXT NOT NULL, total REAL NOT NULL, "
+                "PRIMARY KEY (person, stamp, method, view), FOREIGN KEY (person, stamp) "
+                "REFERENCES feature_state (person, stamp) ON DELETE CASCADE) WITHOUT ROWID;",
+            "CREATE INDEX IF NOT EXISTS feature_core_type ON feature_core (stamp, method, view, type);",
+            "CREATE TRIGGER IF NOT EXISTS persons_feature "
+                "AFTER UPDATE OF dateTime, lat, lon, hsys, patch ON persons BEGIN "
+                "DELETE FROM feature_state WHERE person=old.id; END;"};
+        QStringList drop {
+            "DROP TRIGGER IF EXISTS persons_feature;",
+            "DROP TABLE IF EXISTS feature_core;",
+            "DROP TABLE IF EXISTS feature_config;",
+            "DROP TABLE IF EXISTS feature_aspect;",
+            "DROP TABLE IF EXISTS feature_body;",
+            "DROP TABLE IF EXISTS feature_state;",
+            "DROP TABLE IF EXISTS feature_stamp;"};
+
+        QString version {"PRAGMA data_version;"};
+        QString stamp {"INSERT INTO feature_stamp (stamp, page, used) VALUES (?, ?, ?) "
+                       "ON CONFLICT (stamp) DO UPDATE SET used=excluded.used;"};
+        QString prune {"DELETE FROM feature_stamp WHERE stamp NOT IN ("
+                           "SELECT stamp FROM feature_stamp ORDER BY used DESC LIMIT ?);"};
+        QString stale {"SELECT p.* FROM persons p WHERE NOT EXISTS ("
+                           "SELECT 1 FROM feature_state s WHERE s.person=p.id AND s.stamp=?) "
+                       "AND p.id > ? ORDER BY p.id LIMIT ?;"};
+
+        QString state {"INSERT INTO feature_state (person, stamp) VALUES (?, ?);"};
+        QString body {"INSERT INTO feature_body (person, stamp, body, crd, sign, house) "
+                      "VALUES (?, ?, ?, ?, ?, ?);"};
+        QString aspect {"INSERT INTO feature_aspect (person, stamp, bodyA, bodyB, asp, orb, acc) "
+                        "VALUES (?, ?, ?, ?, ?, ?, ?);"};
+        QString config {"INSERT INTO feature_config (person, stamp, config, member) VALUES (?, ?, ?, ?);"};
+        QString core {"INSERT INTO feature_core (person, stamp, method, view, type, total) "
+                      "VALUES (?, ?, ?, ?, ?, ?);"};
+    };
+
+private :
+    Kernel& kernel_;
+    SqlConnection dbase_;
+    QTimer* timer_;
+
+    qint64 stamp_;
+    qint64 version_;
+    qint64 lastId_;
+    bool   isIdle_;
+
+    static const SqlMask mask_;
+
+    static constexpr int stepSize_ {16};
+    static constexpr int pollDelay_ {2000};
+    static constexpr int stampCap_ {4};
+
+private slots :
+    void onStep();
+
+private :
+    auto useStamp(qint64 stamp) -> bool;
+    auto store(const std::vector<qint64>& id, const std::vector<ChartFeatures>& feature) -> bool;
+    auto dataVersion() -> qint64;
+};
+
+} // namespace napatahti
+
+#endif // FEATUREINDEX_H
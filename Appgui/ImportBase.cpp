@@ -0,0 +1,107 @@
+#include <QFileInfo>
+#include <QElapsedTimer>
+#include "shared.h"
+#include "ImportBase.h"
+
+namespace napatahti {
+
+ImportBase::ImportBase(SqlConnection& dbase)
+    : dbase_ (dbase)
+    , logged_ (0)
+{}
+
+
+auto ImportBase::exec(const QString& fileName, const progress_t& progress) -> Report
+{
+    QElapsedTimer timer;
+
+    report_ = {};
+    timer.start();
+
+    QFile file (fileName);
+
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        errorLog("Can not open " + fileName + " : " + file.errorString());
+        return report_;
+    }
+
+    if (!dbase_.open())
+    {
+        errorLog("Can not open " + dbase_.getName() + " : " + dbase_.lastError().text());
+        return report_;
+    }
+
+    fileName_ = QFileInfo(fileName).fileName();
+    logged_ = 0;
+
+    QTextStream stream (&file);
+
+    if (!begin(fileName_, file, stream))
+        return report_;
+
+    auto size (std::max<qint64>(file.size(), 1));
+    auto batch (0);
+
+    dbase_.transaction();
+
+    while (!stream.atEnd())
+    {
+        auto step (next(stream));
+
+        if (step == Step::Stop)
+            break;
+
+        if (step == Step::Skip || ++batch < batch_)
+            continue;
+
+        batch = 0;
+        dbase_.commit();
+
+        if (progress && !progress(static_cast<double>(file.pos()) / size))
+        {
+            report_.canceled = true;
+            break;
+        }
+
+        dbase_.transaction();
+    }
+
+    if (!report_.canceled)
+        dbase_.commit();
+
+    if (report_.skipped > logged_)
+        errorLog("Import " + fileName_ + " : " +
+                 QString::number(report_.skipped - logged_) + " more rows skipped");
+
+    report_.msecs = timer.elapsed();
+
+    return report_;
+}
+
+
+auto ImportBase::insert(QSqlQuery& query, int line) -> void
+{
+    // Inserts are OR IGNORE on the table key, an ignored one is a duplicate
+    if (!query.exec())
+        skip(line, query.lastError().text());
+    else if (query.numRowsAffected() > 0)
+        ++report_.inserted;
+    else
+        ++report_.duplicate;
+}
+
+
+auto ImportBase::skip(int line, const QString& error) -> void
+{
+    ++report_.skipped;
+
+    // A broken dump should not flood the log
+    if (logged_ >= logCap_)
+        return;
+
+    ++logged_;
+    errorLog("Import " + fileName_ + " : line " + QString::number(line) + " : " + error);
+}
+
+} // namespace napatahti
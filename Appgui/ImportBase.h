@@ -0,0 +1,65 @@
+#ifndef IMPORTBASE_H
+#define IMPORTBASE_H
+
+#include <functional>
+#include <QFile>
+#include <QTextStream>
+#include "SharedGui.h"
+#include "SqlConnection.h"
+
+namespace napatahti {
+
+class ConfigDialog;
+
+
+// The batch loop of the text imports: rows go in by transactions of batch_,
+// progress and cancel are checked between them, broken rows are logged up to a cap
+class ImportBase : protected SharedGui
+{
+public :
+    using progress_t = std::function<bool(double)>;
+
+    struct Report {
+        int    read {0};
+        int    inserted {0};
+        int    duplicate {0};
+        int    skipped {0};
+        qint64 msecs {0};
+        bool   canceled {false};
+
+        auto rate() const { return msecs > 0 ? 1000.0 * read / msecs : 0.0; }
+    };
+
+    static auto getBatch() { return batch_; }
+
+protected :
+    enum class Step { Skip, Row, Stop };
+
+    explicit ImportBase(SqlConnection& dbase);
+    virtual ~ImportBase() {}
+
+    SqlConnection& dbase_;
+    Report report_;
+
+protected :
+    auto exec(const QString& fileName, const progress_t& progress) -> Report;
+    auto insert(QSqlQuery& query, int line) -> void;
+    auto skip(int line, const QString& error) -> void;
+
+    virtual auto begin(const QString& fileName, QFile& file, QTextStream& stream) -> bool = 0;
+    virtual auto next(QTextStream& stream) -> Step = 0;
+
+private :
+    QString fileName_;
+    int     logged_;
+
+    static int batch_;
+
+    static constexpr int logCap_ {100};
+
+    friend ConfigDialog;
+};
+
+} // namespace napatahti
+
+#endif // IMPORTBASE_H
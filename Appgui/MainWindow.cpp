@@ -1,4 +1,5 @@
 #include <QActionGroup>
+#include <QElapsedTimer>
 #include <QFileDialog>
 #include <QtPrintSupport/QPrinter>
 #include <QtPrintSupport/QPrintDialog>
@@ -8,6 +9,7 @@
 #include "Kernel/Kernel.h"
 #include "SharedGui.h"
 #include "Canvas.h"
+#include "ChartRender.h"
 #include "LineEditDialog.h"
 #include "AtlasDialog.h"
 #include "PersonDialog.h"
@@ -17,6 +19,7 @@
 #include "AspTableDialog.h"
 #include "TCounterDialog.h"
 #include "ConfigDialog.h"
+#include "FeatureIndex.h"
 #include "AboutDialog.h"
 #include "MainWindow.h"
 #include "ui_MainWindow.h"
@@ -30,13 +33,16 @@ MainWindow::MainWindow(QWidget* root)
     , canvas_ (new Canvas(*kernel_, this))
     , atlasDialog_ (new AtlasDialog(this))
     , personDialog_ (new PersonDialog(atlasDialog_, this))
-    , dbaseDialog_ (new DataBaseDialog(kernel_->person(), atlasDialog_, this))
+    , dbaseDialog_ (new DataBaseDialog(
+        kernel_->person(), kernel_->astroBase(), kernel_->aspTable(), atlasDialog_, this))
     , aspPageDialog_ (new AspPageDialog(kernel_->aspPage(), this))
     , catalogDialog_ (new CatalogDialog(kernel_->astroBase(), this))
     , aspTableDialog_ (new AspTableDialog(
         kernel_->person(), kernel_->astroBase(), kernel_->aspPage(), kernel_->aspTable(), this))
-    , tCounterDialog_ (new TCounterDialog(&kernel_->person(), this))
+    , tCounterDialog_ (new TCounterDialog(
+        &kernel_->person(), kernel_->astroBase(), kernel_->aspPage(), this))
     , configDialog_ (new ConfigDialog(atlasDialog_, this))
+    , featureIndex_ (new FeatureIndex(*kernel_, this))
 {
     setupBase();
 
@@ -48,9 +54,13 @@ MainWindow::MainWindow(QWidget* root)
 
     // DataBaseDialog setup ------------------------------------------------ //
     connect(dbaseDialog_, &DataBaseDialog::personChanged, this, &MainWindow::onUpdate);
+    connect(dbaseDialog_, &DataBaseDialog::personPrefetch, this, [this](const Person& person) {
+        kernel_->prefetch(person, Canvas::getPlanetSpace(), trigger_.aspCfgClassOnly);
+    });
     connect(dbaseDialog_, &DataBaseDialog::patchNeedSync, aspTableDialog_, &AspTableDialog::reloadTable);
     connect(dbaseDialog_, &DataBaseDialog::personNeedSync, personDialog_, &PersonDialog::onDialogSync);
     connect(dbaseDialog_, &DataBaseDialog::personNeedSync, tCounterDialog_, &TCounterDialog::onDialogSync);
+    connect(dbaseDialog_, &DataBaseDialog::featureIndexToggled, featureIndex_, &FeatureIndex::onEnable);
 
     // AspPageDialog setup ------------------------------------------------- //
     connect(aspPageDialog_, &AspPageDialog::aspPageChanged, this, &MainWindow::onUpdate);
@@ -62,6 +72,7 @@ MainWindow::MainWindow(QWidget* root)
 
     // AspTableDialog setup ------------------------------------------------ //
     connect(aspTableDialog_, &AspTableDialog::patchChanged, this, &MainWindow::onUpdate);
+    connect(aspTableDialog_, &AspTableDialog::patchPairChanged, this, &MainWindow::onPatchPairChange);
     connect(aspTableDialog_, &AspTableDialog::personNeedSync, personDialog_, &PersonDialog::onDialogSync);
 
     // TCounterDialog setup ------------------------------------------------ //
@@ -87,27 +98,72 @@ MainWindow::~MainWindow()
 
 void MainWindow::onUpdate(int kMask, int cMask)
 {
+    auto space (Canvas::getPlanetSpace());
+    auto cached (kMask > 0 && (kMask & KernelMask::Cached) != 0);
+
+    auto& trace (canvas_->getTrace());
+    RenderTrace::Scope frame (trace, "onUpdate", "frame");
+
+    // Once for a cache hit and a miss alike, the miss recomputes the base below
+    if (cached || kMask == 0 || (kMask > 0 && (kMask & KernelMask::AstroBase) != 0))
+        kernel_->setHeaderStr();
+
+    if (cached)
+    {
+        RenderTrace::Scope stage (trace, "loadCache", "kernel");
+        kMask = kernel_->loadCache(space, trigger_.aspCfgClassOnly) ? -1 : 0;
+    }
+    else if (kMask >= 0)
+        kernel_->clearCache();
+
     if (kMask >= 0)
     {
         if (kMask == 0 || (kMask & KernelMask::AstroBase) != 0)
         {
-            kernel_->setHeaderStr();
-            kernel_->AstroBase::update(Canvas::getPlanetSpace(), SharedGui::getAppLocale());
+            RenderTrace::Scope stage (trace, "AstroBase", "kernel");
+            kernel_->AstroBase::update(space, SharedGui::getAppLocale());
         }
         if ((kMask & KernelMask::Coupling) != 0)
-            kernel_->computeCoupling(Canvas::getPlanetSpace());
+        {
+            RenderTrace::Scope stage (trace, "computeCoupling", "kernel");
+            kernel_->computeCoupling(space);
+        }
         if (kMask == 0 || (kMask & KernelMask::AspTable) != 0)
+        {
+            RenderTrace::Scope stage (trace, "AspTable", "kernel");
             kernel_->AspTable::update(true, kernel_->getAccKey(), trigger_.aspCfgClassOnly);
+        }
         if ((kMask & KernelMask::AspCfg) != 0)
+        {
+            RenderTrace::Scope stage (trace, "AspCfg", "kernel");
             kernel_->AspTable::update(false, kernel_->getAccKey(), trigger_.aspCfgClassOnly);
+        }
         if ((kMask & KernelMask::AspTableStar) != 0)
+        {
+            RenderTrace::Scope stage (trace, "computeStarTable", "kernel");
             kernel_->computeStarTable();
+        }
         if (kMask == 0 || (kMask & KernelMask::PrimeTest) != 0)
+        {
+            RenderTrace::Scope stage (trace, "PrimeTest", "kernel");
             kernel_->PrimeTest::update();
+        }
         if (kMask == 0 || (kMask & KernelMask::AshaTest) != 0)
+        {
+            RenderTrace::Scope stage (trace, "AshaTest", "kernel");
             kernel_->AshaTest::update();
+        }
         if (kMask == 0 || (kMask & KernelMask::CosmicTest) != 0)
+        {
+            RenderTrace::Scope stage (trace, "CosmicTest", "kernel");
             kernel_->CosmicTest::update();
+        }
+
+        if (cached)
+        {
+            RenderTrace::Scope stage (trace, "saveCache", "kernel");
+            kernel_->saveCache(space, trigger_.aspCfgClassOnly);
+        }
     }
 
     if (cMask >= 0)
@@ -136,6 +192,13 @@ void MainWindow::onUpdate(int kMask, int cMask)
 }
 
 
+void MainWindow::onPatchPairChange(int keyA, int keyB)
+{
+    if (kernel_->AspTable::updatePair({keyA, keyB}, kernel_->getAccKey(), trigger_.aspCfgClassOnly))
+        onUpdate(KernelMask::AspTablePair, CanvasMask::AspTableFull);
+}
+
+
 void MainWindow::onDataSaveAs(const QAction* action)
 {
     QString name (kernel_->person().name);
@@ -143,7 +206,7 @@ void MainWindow::onDataSaveAs(const QAction* action)
     QString format (tr("Text files") + " (*.txt)");
 
     if (action == ui->actSaveAsMap)
-        format = tr("Image") + " (*.png)";
+        format = ChartRender::getFilter();
     else if (action == ui->actSaveAsCalendar)
     {
         name += " - " + tr("Moon calendar");
@@ -177,7 +240,9 @@ void MainWindow::onDataSaveAs(const QAction* action)
     {
         if (action == ui->actSaveAsMap)
         {
-            if (!canvas_->grab().save(fileName))
+            auto size (canvas_->viewport()->size() * canvas_->devicePixelRatioF());
+
+            if (!ChartRender::save(canvas_->toPicture(), fileName, size))
                 errorLog("can not save " + name);
         }
         else
@@ -207,18 +272,67 @@ void MainWindow::onPrintMap()
 
     if (printDialog.exec() == QDialog::Accepted)
     {
-        QPixmap imgGrab (canvas_->grab());
-        QPainter painter (&printer);
-        QRectF imgRect (imgGrab.rect());
-        QRectF rect (painter.viewport());
-        double k (imgRect.height() * rect.width() / rect.height());
-
-        painter.setWindow(0, (imgRect.height() - k) / 2, imgRect.width(), k);
-        painter.drawPixmap(0, 0, imgGrab);
+        // Vectors at the resolution of the printer, not a stretched screen grab
+        if (!ChartRender::paint(canvas_->toPicture(), &printer))
+            errorLog("can not print " + kernel_->person().name);
     }
 }
 
 
+void MainWindow::onRenderBench()
+{
+    auto& person (kernel_->person());
+    auto  backup (person);
+    auto& range (AstroBase::getEpheRange());
+
+    // Steps as the time counter does, an hour a frame, away from the nearer end of the ephemeris
+    auto step (person.dateTime.addSecs(benchFrames_ * benchStep_) > range[1] ? -benchStep_ : benchStep_);
+
+    person.table.clear();
+
+    // Every frame is a miss and a throwaway, it should not evict the charts in use
+    kernel_->holdCache(true);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (auto i (0); i < benchFrames_; ++i)
+    {
+        person.dateTime = person.dateTime.addSecs(step);
+        onUpdate(KernelMask::Cached, 0);
+        canvas_->viewport()->repaint();
+    }
+
+    auto elapsed (std::max(timer.elapsed(), qint64(1)));
+
+    kernel_->holdCache(false);
+    person = backup;
+    onUpdate(KernelMask::Cached, 0);
+
+    ui->statusbar->showMessage(QString("%1 : %2 fps, %3 ms")
+        .arg(tr("Render"))
+        .arg(1000.0 * benchFrames_ / elapsed, 0, 'f', 1)
+        .arg(elapsed), 10000);
+}
+
+
+void MainWindow::onTraceSave()
+{
+    auto fileName (QFileDialog::getSaveFileName(this, tr("Save as"), "trace.json", "JSON (*.json)"));
+    if (fileName.isEmpty())
+        return;
+
+    QFile file (fileName);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        errorLog("can not save " + fileName);
+        return;
+    }
+
+    file.write(canvas_->getTrace().toJson());
+}
+
+
 void MainWindow::onViewSet(const QAction* action)
 {
     trigger_.set(action);
@@ -355,8 +469,9 @@ void MainWindow::onDialogShow(const QAction* action)
 void MainWindow::onCanvasMenu(const QPoint& pos)
 {
     auto& context (canvas_->getContextMap());
+    auto  point (canvas_->mapToScene(pos));
 
-    if (trigger_.viewHeader && context.header.contains(pos))
+    if (trigger_.viewHeader && context.header.contains(point))
     {
         auto menu (new QMenu(this));
         menu->addAction(ui->trigModeJyotisa);
@@ -365,13 +480,13 @@ void MainWindow::onCanvasMenu(const QPoint& pos)
         menu->addAction(ui->actSaveAsCalendar);
         menu->exec(canvas_->mapToGlobal(pos));
     }
-    else if (trigger_.viewEsseStat && context.esseStat.contains(pos))
+    else if (trigger_.viewEsseStat && context.esseStat.contains(point))
         ui->menuEsseStat->exec(canvas_->mapToGlobal(pos));
-    else if (trigger_.viewCircle && context.circle.contains(pos))
+    else if (trigger_.viewCircle && context.circle.contains(point))
         ui->menuCircle->exec(canvas_->mapToGlobal(pos));
-    else if (trigger_.viewCrdTable && context.crdTable.contains(pos))
+    else if (trigger_.viewCrdTable && context.crdTable.contains(point))
         ui->menuCrdTable->exec(canvas_->mapToGlobal(pos));
-    else if (trigger_.viewLineBar && context.lineBar.contains(pos))
+    else if (trigger_.viewLineBar && context.lineBar.contains(point))
     {
         auto menu (new QMenu(this));
         menu->addMenu(ui->menuLineBarMode);
@@ -403,9 +518,9 @@ void MainWindow::onCanvasMenu(const QPoint& pos)
 
         menu->exec(canvas_->mapToGlobal(pos));
     }
-    else if (trigger_.viewAspCfg && context.aspCfg.contains(pos))
+    else if (trigger_.viewAspCfg && context.aspCfg.contains(point))
         ui->menuAspCfg->exec(canvas_->mapToGlobal(pos));
-    else if (trigger_.viewCoreStat && context.coreStat.contains(pos))
+    else if (trigger_.viewCoreStat && context.coreStat.contains(point))
     {
         auto menu (new QMenu(this));
         menu->addAction(ui->trigModeGloba);
@@ -519,6 +634,26 @@ auto MainWindow::setupBase() -> void
     connect(agSaveAs, &QActionGroup::triggered, this, &MainWindow::onDataSaveAs);
     connect(ui->actPrintMap, &QAction::triggered, this, &MainWindow::onPrintMap);
 
+    // Render benchmark, a shortcut only ----------------------------------- //
+    auto actBench (new QAction(this));
+    actBench->setShortcut(QKeySequence("Ctrl+Shift+F12"));
+    addAction(actBench);
+
+    connect(actBench, &QAction::triggered, this, &MainWindow::onRenderBench);
+
+    // Render trace, an overlay with the stage times and a dump for a trace viewer
+    auto actTrace (new QAction(this));
+    actTrace->setShortcut(QKeySequence("Ctrl+Shift+F11"));
+    actTrace->setCheckable(true);
+    addAction(actTrace);
+
+    auto actTraceSave (new QAction(this));
+    actTraceSave->setShortcut(QKeySequence("Ctrl+Shift+F10"));
+    addAction(actTraceSave);
+
+    connect(actTrace, &QAction::toggled, canvas_, &Canvas::onShowTrace);
+    connect(actTraceSave, &QAction::triggered, this, &MainWindow::onTraceSave);
+
     applyTrigger();
 
     // Menu View ----------------------------------------------------------- //
@@ -22,6 +22,7 @@ class CatalogDialog;
 class AspTableDialog;
 class TCounterDialog;
 class ConfigDialog;
+class FeatureIndex;
 
 
 class MainWindow : public QMainWindow
@@ -36,9 +37,12 @@ public :
 
 private slots :
     void onUpdate(int kMask, int cMask);
+    void onPatchPairChange(int keyA, int keyB);
 
     void onDataSaveAs(const QAction* action);
     void onPrintMap();
+    void onRenderBench();
+    void onTraceSave();
 
     void onViewSet(const QAction* action);
     void onHeaderSet(const QAction* action);
@@ -69,12 +73,16 @@ private :
     AspTableDialog* aspTableDialog_;
     TCounterDialog* tCounterDialog_;
     ConfigDialog*   configDialog_;
+    FeatureIndex*   featureIndex_;
 
     QActionGroup* agAccKey_;
     QActionGroup* agCoreMode_;
 
     static AppTrigger trigger_;
 
+    static constexpr int benchFrames_ {240};
+    static constexpr int benchStep_ {3600};
+
 private :
     auto setupBase() -> void;
     auto setProfileMenu() -> void;
@@ -0,0 +1,230 @@
+#ifndef PAGEDMODEL_H
+#define PAGEDMODEL_H
+
+#include <map>
+#include <algorithm>
+#include <QAbstractTableModel>
+#include "shared.h"
+#include "Kernel/RefBook.h"
+#include "SharedGui.h"
+#include "SqlConnection.h"
+
+namespace napatahti {
+
+// A table model over a large SQL table, rows are fetched in pages as they are shown
+// and sorted by the base; derived models give the row type, sort keys and cells
+template <class T>
+class PagedModel : public QAbstractTableModel, protected SharedGui
+{
+public :
+    struct PageMask {
+        QString count;
+        QString page;
+        QString seek;
+        QString rank;
+    };
+
+    explicit PagedModel(SqlConnection& dbase, const PageMask& mask, QObject* root=nullptr);
+
+    virtual auto reload() -> void;
+
+    auto rowCount(const QModelIndex& parent={}) const -> int;
+    auto sort(int column, Qt::SortOrder order=Qt::AscendingOrder) -> void;
+
+protected :
+    SqlConnection& dbase_;
+
+    int  count_;
+    int  column_;
+    Qt::SortOrder order_;
+
+    static constexpr int pageSize_ {256};
+    static constexpr int pageCap_ {64};
+
+protected :
+    auto getRow(int row) const -> const T*;
+    auto rankOf(QSqlQuery& query) const -> int;
+    auto isOpen() const -> bool;
+    auto orderStr() const -> QString { return order_ == Qt::AscendingOrder ? "ASC" : "DESC"; }
+
+    virtual auto sortKey() const -> QString = 0;
+    virtual auto makeRow(const QSqlQuery& query) const -> T = 0;
+    virtual auto scope(const QString& sql) const -> QString { return sql; }
+    virtual auto bindScope(QSqlQuery&) const -> void {}
+
+private :
+    struct Page {
+        std::vector<T> rows;
+        QVariant lastKey;
+        qint64   lastRowid;
+    };
+
+    const PageMask pageMask_;
+    mutable std::map<int, Page> page_;
+
+private :
+    auto fetchPage(int page) const -> const Page*;
+};
+
+//---------------------------------------------------------------------------//
+
+template <class T>
+PagedModel<T>::PagedModel(SqlConnection& dbase, const PageMask& mask, QObject* root)
+    : QAbstractTableModel (root)
+    , dbase_ (dbase)
+    , count_ (0)
+    , column_ (0)
+    , order_ (Qt::AscendingOrder)
+    , pageMask_ (mask)
+{}
+
+
+template <class T>
+auto PagedModel<T>::reload() -> void
+{
+    beginResetModel();
+
+    page_.clear();
+    count_ = 0;
+
+    if (isOpen())
+    {
+        auto& query (dbase_.prepare(scope(pageMask_.count)));
+        bindScope(query);
+
+        if (query.exec() && query.next())
+            count_ = query.value(0).toInt();
+
+        query.finish();
+    }
+
+    endResetModel();
+}
+
+
+template <class T>
+auto PagedModel<T>::rowCount(const QModelIndex& parent) const -> int
+{
+    return parent.isValid() ? 0 : count_;
+}
+
+
+template <class T>
+auto PagedModel<T>::sort(int column, Qt::SortOrder order) -> void
+{
+    if (column < 0 || column >= columnCount() || (column == column_ && order == order_))
+        return;
+
+    column_ = column;
+    order_ = order;
+
+    reload();
+}
+
+
+template <class T>
+auto PagedModel<T>::getRow(int row) const -> const T*
+{
+    if (row < 0 || row >= count_)
+        return nullptr;
+
+    auto page (fetchPage(row / pageSize_));
+    auto ind (static_cast<std::size_t>(row % pageSize_));
+
+    if (page == nullptr || ind >= page->rows.size())
+        return nullptr;
+
+    return &page->rows[ind];
+}
+
+
+template <class T>
+auto PagedModel<T>::rankOf(QSqlQuery& query) const -> int
+{
+    auto& rank (dbase_.prepare(scope(pageMask_.rank.arg(sortKey())
+                                         .arg(order_ == Qt::AscendingOrder ? '<' : '>'))));
+    bindScope(rank);
+    rank.addBindValue(query.value("sortKey"));
+    rank.addBindValue(query.value("rowid"));
+
+    auto row (rank.exec() && rank.next() ? rank.value(0).toInt() : NONE);
+    rank.finish();
+
+    return row;
+}
+
+
+template <class T>
+auto PagedModel<T>::isOpen() const -> bool
+{
+    if (dbase_.open())
+        return true;
+
+    errorLog("Can not open " + dbase_.getName() + " : " + dbase_.lastError().text());
+    return false;
+}
+
+
+template <class T>
+auto PagedModel<T>::fetchPage(int page) const -> const Page*
+{
+    auto check (page_.find(page));
+    if (check != page_.end())
+        return &check->second;
+
+    if (!isOpen())
+        return nullptr;
+
+    // The next page is sought from the last key of the previous one,
+    // only a jump pays for an offset scan
+    auto prev (page_.find(page - 1));
+    auto seek (prev != page_.end() && !prev->second.lastKey.isNull());
+
+    auto& query (dbase_.prepare(scope(seek
+        ? pageMask_.seek.arg(sortKey()).arg(orderStr())
+              .arg(order_ == Qt::AscendingOrder ? '>' : '<')
+        : pageMask_.page.arg(sortKey()).arg(orderStr()))));
+
+    bindScope(query);
+
+    if (seek)
+    {
+        query.addBindValue(prev->second.lastKey);
+        query.addBindValue(prev->second.lastRowid);
+        query.addBindValue(pageSize_);
+    }
+    else
+    {
+        query.addBindValue(pageSize_);
+        query.addBindValue(page * pageSize_);
+    }
+
+    Page res {{}, {}, 0};
+
+    if (query.exec())
+    {
+        res.rows.reserve(pageSize_);
+
+        while (query.next())
+        {
+            res.rows.push_back(makeRow(query));
+            res.lastKey = query.value("sortKey");
+            res.lastRowid = query.value("rowid").toLongLong();
+        }
+    }
+    else
+        errorLog("Can not fetch " + dbase_.getName() + " : " + query.lastError().text());
+
+    query.finish();
+
+    if (page_.size() >= pageCap_)
+        page_.erase(std::max_element(page_.begin(), page_.end(), [page](auto& lhs, auto& rhs) {
+            return std::abs(lhs.first - page) < std::abs(rhs.first - page);
+        }));
+
+    return &page_.emplace(page, std::move(res)).first->second;
+}
+
+} // namespace napatahti
+
+#endif // PAGEDMODEL_H
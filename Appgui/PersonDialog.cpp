@@ -32,6 +32,7 @@ PersonDialog::PersonDialog(AtlasDialog* atlas, QWidget* root)
 
     connect(ui->atlasButton, &QPushButton::clicked, this, &PersonDialog::onClickAtlas);
     connect(ui->saveCityButton, &QPushButton::clicked, this, &PersonDialog::onClickSaveCity);
+    connect(ui->nearButton, &QPushButton::clicked, this, &PersonDialog::onClickNearest);
 
     connect(atlas_, &AtlasDialog::citySelected, this, &PersonDialog::onCitySelect);
 
@@ -99,6 +100,22 @@ void PersonDialog::onClickSaveCity()
 }
 
 
+void PersonDialog::onClickNearest()
+{
+    if (!ui->latEdit->hasAcceptableInput() || !ui->lonEdit->hasAcceptableInput())
+        return;
+
+    auto near (atlas_->findNearest(toIntCrd(ui->latEdit->text()), toIntCrd(ui->lonEdit->text())));
+
+    // The coordinates stay as typed, only the place and its zone are taken
+    if (!near.empty())
+    {
+        ui->cityTitleEdit->setText(near[0].title);
+        ui->utcEdit->setText(toStrUtc(near[0].utc, true));
+    }
+}
+
+
 void PersonDialog::onCitySelect(const QVariantMap& city)
 {
     if (atlasRoot_ == this)
@@ -278,7 +295,7 @@ auto PersonDialog::dataFromForm() -> Person
         toIntCrd(ui->latEdit->text()),
         toIntCrd(ui->lonEdit->text()),
         ui->hsysBox->currentData().toInt(),
-        dateTime == person_->dateTime ? person_->patch : "",
+        dateTime == person_->dateTime ? person_->patch : AspPatch(),
         person_->table
     };
 }
@@ -65,6 +65,7 @@ private :
 private slots :
     void onClickAtlas();
     void onClickSaveCity();
+    void onClickNearest();
     void onCitySelect(const QVariantMap& city);
 
     void onChangeMode();
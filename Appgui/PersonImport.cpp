@@ -0,0 +1,418 @@
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include "shared.h"
+#include "Kernel/RefBook.h"
+#include "PersonDialog.h"
+#include "PersonImport.h"
+
+namespace napatahti {
+
+PersonImport::PersonImport(SqlConnection& dbase, AtlasDialog* atlas)
+    : ImportBase (dbase)
+    , atlas_ (atlas)
+    , default_ ()
+    , insert_ (nullptr)
+    , isJson_ (false)
+    , delim_ (',')
+    , line_ (0)
+{}
+
+
+auto PersonImport::exec(const QString& fileName, const QString& table, const progress_t& progress) -> Report
+{
+    table_ = table;
+    column_.clear();
+    line_ = 0;
+
+    return ImportBase::exec(fileName, progress);
+}
+
+
+auto PersonImport::begin(const QString& fileName, QFile& file, QTextStream& stream) -> bool
+{
+    // The first line tells the format and, for CSV, the delimiter
+    auto head (QString::fromUtf8(file.peek(4096)));
+    if (head.startsWith(QChar(0xFEFF)))
+        head.remove(0, 1);
+    head = head.left(head.indexOf('\n')).trimmed();
+
+    isJson_ = head.startsWith('{');
+    delim_ = ',';
+
+    for (auto i : {';', '\t'})
+        if (head.count(i) > head.count(delim_))
+            delim_ = i;
+
+    if (!isJson_)
+    {
+        readCsv(stream, delim_, field_, line_);
+
+        for (auto& i : field_)
+            column_.push_back(toField(i));
+
+        if (!contains(static_cast<int>(Field::Name), column_))
+        {
+            errorLog("Can not import " + fileName + " : no name column in the header");
+            return false;
+        }
+    }
+
+    insert_ = &dbase_.prepare(mask_.insert);
+
+    return true;
+}
+
+
+auto PersonImport::next(QTextStream& stream) -> Step
+{
+    record_t record;
+    auto at (line_ + 1);
+
+    if (isJson_)
+    {
+        auto text (stream.readLine().trimmed());
+        ++line_;
+
+        if (text.isEmpty())
+            return Step::Skip;
+
+        if (!readJson(text, record))
+        {
+            ++report_.read;
+            skip(at, "not a JSON object");
+            return Step::Skip;
+        }
+    }
+    else
+    {
+        if (!readCsv(stream, delim_, field_, line_))
+            return Step::Stop;
+        if (field_.size() == 1 && field_[0].trimmed().isEmpty())
+            return Step::Skip;
+
+        for (auto i (0); i < std::min<int>(field_.size(), column_.size()); ++i)
+            if (column_[i] != NONE)
+                record[column_[i]] = field_[i].trimmed();
+    }
+
+    Person  person (default_);
+    QString error;
+
+    ++report_.read;
+
+    if (!toPerson(record, person, error))
+    {
+        skip(at, error);
+        return Step::Skip;
+    }
+
+    insert_->addBindValue(table_);
+    insert_->addBindValue(person.name);
+    insert_->addBindValue(person.dateTime);
+    insert_->addBindValue(person.sex);
+    insert_->addBindValue(person.location);
+    insert_->addBindValue(person.lat);
+    insert_->addBindValue(person.lon);
+    insert_->addBindValue(person.hsys);
+    insert_->addBindValue(person.patch.toBlob());
+
+    // The key is (groupName, name, dateTime, sex)
+    insert(*insert_, at);
+
+    return Step::Row;
+}
+
+
+auto PersonImport::toPerson(const record_t& record, Person& person, QString& error) -> bool
+{
+    person.name = record[Field::Name];
+
+    if (person.name.isEmpty())
+    {
+        error = "no name";
+        return false;
+    }
+
+    auto ok (true);
+    auto utc (0);
+    auto isUtc (!record[Field::Utc].isEmpty());
+    QDate date;
+    QTime time;
+
+    if (isUtc)
+    {
+        utc = toUtc(record[Field::Utc], ok);
+        if (!ok)
+        {
+            error = "bad utc " + record[Field::Utc];
+            return false;
+        }
+    }
+
+    if (!record[Field::DateTime].isEmpty())
+    {
+        auto dateTime (QDateTime::fromString(record[Field::DateTime], Qt::ISODate));
+
+        date = dateTime.date();
+        time = dateTime.time();
+
+        // An explicit offset in the stamp stands for the utc column
+        if (dateTime.isValid() && !isUtc && dateTime.timeSpec() != Qt::LocalTime)
+        {
+            utc = dateTime.offsetFromUtc();
+            isUtc = true;
+        }
+    }
+    else
+    {
+        date = QDate::fromString(record[Field::Date], Qt::ISODate);
+        if (!date.isValid())
+            date = QDate::fromString(record[Field::Date], "dd.MM.yyyy");
+
+        time = record[Field::Time].isEmpty()
+            ? QTime(12, 0)
+            : QTime::fromString(record[Field::Time], Qt::ISODate);
+    }
+
+    if (!date.isValid() || !time.isValid())
+    {
+        error = "bad date or time";
+        return false;
+    }
+
+    person.location = record[Field::Location];
+
+    auto& city (findCity(person.location));
+    auto  isCity (city.has_value());
+
+    if (!record[Field::Lat].isEmpty() || !record[Field::Lon].isEmpty())
+    {
+        auto okLat (true), okLon (true);
+
+        person.lat = toCrd(record[Field::Lat], true, okLat);
+        person.lon = toCrd(record[Field::Lon], false, okLon);
+
+        if (!okLat || !okLon)
+        {
+            error = "bad coordinates";
+            return false;
+        }
+
+        // An unnamed or unknown place borrows the zone, and for the
+        // unnamed one the title, of the city nearest to it
+        if ((!isUtc && !isCity) || person.location.isEmpty())
+        {
+            auto near (atlas_->findNearest(person.lat, person.lon));
+
+            if (!near.empty())
+            {
+                if (person.location.isEmpty())
+                    person.location = near[0].title;
+
+                if (!isUtc && !isCity)
+                {
+                    utc = near[0].utc;
+                    isUtc = true;
+                }
+            }
+        }
+    }
+    else if (isCity)
+    {
+        person.lat = city->lat;
+        person.lon = city->lon;
+    }
+    else
+    {
+        error = "no coordinates for " + person.location;
+        return false;
+    }
+
+    if (!isUtc)
+    {
+        if (!isCity)
+        {
+            error = "no utc for " + person.location;
+            return false;
+        }
+        utc = city->utc;
+    }
+
+    person.dateTime = QDateTime(date, time, Qt::OffsetFromUTC, utc);
+
+    if (!record[Field::Sex].isEmpty())
+    {
+        auto sex (record[Field::Sex][0].toUpper().toLatin1());
+        person.sex = contains(static_cast<int>(sex), PersonDialog::sexOrder) ? sex : 'E';
+    }
+
+    if (!record[Field::Hsys].isEmpty())
+    {
+        auto hsys (record[Field::Hsys][0].toUpper().toLatin1());
+        if (contains(static_cast<int>(hsys), PersonDialog::hsysOrder))
+            person.hsys = hsys;
+    }
+
+    // The text form of older databases, "a, b : ang, asp, orb, acc; ..."
+    if (!record[Field::Patch].isEmpty())
+    {
+        auto ok (true);
+        person.patch = AspPatch::fromString(record[Field::Patch], &ok);
+
+        if (!ok)
+        {
+            error = "bad patch " + record[Field::Patch];
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+auto PersonImport::findCity(const QString& title) -> const std::optional<CityModel::City>&
+{
+    // One lookup for each distinct place, a dump repeats its cities many times;
+    // the cache folds case the same way as the atlas key
+    auto key (AtlasDialog::toKey(title));
+    auto iter (city_.find(key));
+
+    if (iter == city_.end())
+        iter = city_.insert(key, atlas_->findCity(title));
+
+    return *iter;
+}
+
+
+auto PersonImport::readCsv(QTextStream& stream, QChar delim, QStringList& field, int& line) -> bool
+{
+    field.clear();
+
+    QString cell;
+    auto quoted (false);
+
+    while (!stream.atEnd())
+    {
+        auto text (stream.readLine());
+        ++line;
+
+        for (auto i (0); i < text.size(); ++i)
+        {
+            auto c (text[i]);
+
+            if (quoted)
+            {
+                if (c != '"')
+                    cell += c;
+                else if (i + 1 < text.size() && text[i + 1] == '"')
+                {
+                    cell += c;
+                    ++i;
+                }
+                else
+                    quoted = false;
+            }
+            else if (c == '"')
+                quoted = true;
+            else if (c == delim)
+            {
+                field.push_back(cell);
+                cell.clear();
+            }
+            else
+                cell += c;
+        }
+
+        // A quoted cell may hold line breaks
+        if (!quoted)
+        {
+            field.push_back(cell);
+            return true;
+        }
+
+        cell += '\n';
+    }
+
+    if (quoted)
+        field.push_back(cell);
+
+    return !field.isEmpty();
+}
+
+
+auto PersonImport::readJson(const QString& text, record_t& record) -> bool
+{
+    auto doc (QJsonDocument::fromJson(text.toUtf8()));
+
+    if (!doc.isObject())
+        return false;
+
+    auto obj (doc.object());
+
+    for (auto i (obj.begin()); i != obj.end(); ++i)
+    {
+        auto key (toField(i.key()));
+        if (key == NONE)
+            continue;
+
+        auto value (i.value());
+        record[key] = value.isDouble()
+            ? QString::number(value.toDouble(), 'g', 12)
+            : value.toString().trimmed();
+    }
+
+    return true;
+}
+
+
+auto PersonImport::toField(const QString& key) -> int
+{
+    auto name (key.trimmed().toLower());
+
+    for (auto i (0u); i < alias_.size(); ++i)
+        if (alias_[i].contains(name))
+            return i;
+
+    return NONE;
+}
+
+
+auto PersonImport::toUtc(const QString& text, bool& ok) -> int
+{
+    static const QRegularExpression utcReg ("^[+-]\\d\\d:\\d\\d$");
+
+    ok = true;
+
+    if (text == "UTC" || utcReg.match(text).hasMatch())
+        return toIntUtc(text);
+
+    // Otherwise it is a number of hours, such as 3 or -9.5
+    auto utc (qRound(3600 * text.toDouble(&ok)));
+    ok = ok && std::abs(utc) <= 14 * 3600;
+
+    return utc;
+}
+
+
+auto PersonImport::toCrd(const QString& text, bool lat, bool& ok) -> int
+{
+    auto limit ((lat ? 90 : 180) * 3600);
+
+    // The application's own form, 55º 45' 00" N
+    if (text.contains(QChar(0x00BA)))
+    {
+        auto side (text.back().toUpper());
+        ok = lat ? side == 'N' || side == 'S' : side == 'E' || side == 'W';
+
+        return ok ? toIntCrd(text.left(text.size() - 1) + side) : 0;
+    }
+
+    // Otherwise decimal degrees, north and east positive
+    auto crd (qRound(3600 * text.toDouble(&ok)));
+    ok = ok && std::abs(crd) <= limit;
+
+    return crd;
+}
+
+} // namespace napatahti
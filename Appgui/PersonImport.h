@@ -0,0 +1,64 @@
+#ifndef PERSONIMPORT_H
+#define PERSONIMPORT_H
+
+#include <array>
+#include <vector>
+#include <optional>
+#include <QHash>
+#include "Kernel/Person.h"
+#include "ImportBase.h"
+#include "AtlasDialog.h"
+
+namespace napatahti {
+
+class PersonImport : public ImportBase
+{
+public :
+    explicit PersonImport(SqlConnection& dbase, AtlasDialog* atlas);
+
+    auto exec(const QString& fileName, const QString& table, const progress_t& progress) -> Report;
+
+public :
+    struct SqlMask {
+        QString insert {"INSERT OR IGNORE INTO persons "
+                        "(groupName, name, dateTime, sex, location, lat, lon, hsys, patch) "
+                        "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);"};
+    };
+
+private :
+    enum Field { Name, DateTime, Date, Time, Utc, Sex, Location, Lat, Lon, Hsys, Patch, Count };
+
+    using record_t = std::array<QString, Field::Count>;
+
+    AtlasDialog*   atlas_;
+    QHash<QString, std::optional<CityModel::City>> city_;
+    Person         default_;
+
+    QString          table_;
+    QSqlQuery*       insert_;
+    bool             isJson_;
+    QChar            delim_;
+    QStringList      field_;
+    std::vector<int> column_;
+    int              line_;
+
+    static const SqlMask mask_;
+    static const std::array<QStringList, Field::Count> alias_;
+
+private :
+    auto begin(const QString& fileName, QFile& file, QTextStream& stream) -> bool;
+    auto next(QTextStream& stream) -> Step;
+
+    auto toPerson(const record_t& record, Person& person, QString& error) -> bool;
+    auto findCity(const QString& title) -> const std::optional<CityModel::City>&;
+
+    static auto readCsv(QTextStream& stream, QChar delim, QStringList& field, int& line) -> bool;
+    static auto readJson(const QString& text, record_t& record) -> bool;
+    static auto toField(const QString& key) -> int;
+    static auto toUtc(const QString& text, bool& ok) -> int;
+    static auto toCrd(const QString& text, bool lat, bool& ok) -> int;
+};
+
+} // namespace napatahti
+
+#endif // PERSONIMPORT_H
@@ -0,0 +1,219 @@
+#include <QApplication>
+#include <QPalette>
+#include "PersonModel.h"
+
+namespace napatahti {
+
+PersonModel::PersonModel(SqlConnection& dbase, QObject* root)
+    : PagedModel (dbase, {mask_.count, mask_.page, mask_.seek, mask_.rank}, root)
+    , isIndexed_ (false)
+    , isFiltered_ (false)
+{}
+
+
+auto PersonModel::reload(const QString& table) -> void
+{
+    table_ = table;
+
+    // The persons are indexed once, later on the triggers
+    // keep the index in step with every change
+    if (dbase_.open())
+        isIndexed_ = dbase_.makeIndex("persons", indexColumn_);
+
+    PagedModel::reload();
+}
+
+
+auto PersonModel::findRow(const QVariantMap& key) const -> int
+{
+    auto row (NONE);
+
+    if (!isOpen())
+        return row;
+
+    auto& query (dbase_.prepare(scope(mask_.locate.arg(sortKey()))));
+    query.addBindValue(table_);
+    query.addBindValue(key["name"]);
+    query.addBindValue(key["dateTime"]);
+    query.addBindValue(key["sex"]);
+
+    if (query.exec() && query.next())
+        row = rankOf(query);
+
+    query.finish();
+
+    return row;
+}
+
+
+auto PersonModel::findRow(const Person& person) const -> int
+{
+    return findRow({
+        {"name", person.name},
+        {"dateTime", person.dateTime},
+        {"sex", person.sex}
+    });
+}
+
+
+auto PersonModel::findPrefix(const QString& text) const -> int
+{
+    auto row (NONE);
+
+    if (!isOpen())
+        return row;
+
+    QString mask (text);
+    mask.replace("\\", "\\\\").replace("%", "\\%").replace("_", "\\_");
+
+    auto& query (dbase_.prepare(scope(mask_.prefix.arg(sortKey()).arg(orderStr()))));
+    query.addBindValue(table_);
+    query.addBindValue(mask + '%');
+
+    if (query.exec() && query.next())
+        row = rankOf(query);
+
+    query.finish();
+
+    return row;
+}
+
+
+auto PersonModel::findText(const QString& text) const -> int
+{
+    // Trigrams need three characters, shorter input stays a name prefix
+    if (!isIndexed_ || text.size() < 3)
+        return findPrefix(text);
+
+    auto row (NONE);
+
+    if (!isOpen())
+        return row;
+
+    // A quoted phrase is matched as a substring of name or location,
+    // hits in the name outweigh those in the location
+    auto& query (dbase_.prepare(scope(mask_.search.arg(sortKey()))));
+    query.addBindValue('"' + QString(text).replace("\"", "\"\"") + '"');
+    query.addBindValue(table_);
+
+    if (query.exec() && query.next())
+        row = rankOf(query);
+
+    query.finish();
+
+    return row;
+}
+
+
+auto PersonModel::setMarked(std::vector<QVariantMap> marked) -> void
+{
+    marked_ = std::move(marked);
+
+    if (count_ > 0)
+        emit dataChanged(index(0, 0), index(count_ - 1, 9), {Qt::ForegroundRole});
+}
+
+
+auto PersonModel::columnCount(const QModelIndex& parent) const -> int
+{
+    return parent.isValid() ? 0 : 10;
+}
+
+
+auto PersonModel::data(const QModelIndex& index, int role) const -> QVariant
+{
+    if (!index.isValid())
+        return {};
+
+    auto column (index.column());
+
+    switch (role) {
+    case Qt::TextAlignmentRole :
+        if (column == 0 || column == 7)
+            return {};
+        return static_cast<int>(Qt::AlignCenter);
+    case Qt::DisplayRole :
+    case Qt::UserRole :
+    case Qt::ForegroundRole :
+        break;
+    default :
+        return {};
+    }
+
+    // Cells are formatted here, only for the rows being painted
+    auto person (getPerson(index.row()));
+    if (person == nullptr)
+        return {};
+
+    if (role == Qt::ForegroundRole)
+    {
+        for (auto& i : marked_)
+            if (person->isCurrent(i))
+                return QApplication::palette().color(QPalette::Disabled, QPalette::Text);
+        return {};
+    }
+
+    if (role == Qt::UserRole)
+        switch (column) {
+        case 1 :
+            return person->dateTime;
+        case 4 :
+            return person->sex;
+        case 5 :
+            return person->lat;
+        case 6 :
+            return person->lon;
+        case 8 :
+            return person->hsys;
+        case 9 :
+            return QVariant::fromValue(person->patch);
+        default :
+            return {};
+        }
+
+    switch (column) {
+    case 0 :
+        return person->name;
+    case 1 :
+        return person->dateTime.date().toString("dd.MM.yyyy");
+    case 2 :
+        return person->dateTime.time().toString("hh:mm");
+    case 3 :
+        return toStrUtc(person->dateTime.offsetFromUtc(), false);
+    case 4 :
+        return QString(static_cast<QChar>(person->sex));
+    case 5 :
+        return toStrCrd(person->lat, true);
+    case 6 :
+        return toStrCrd(person->lon, false);
+    case 7 :
+        return person->location;
+    case 8 :
+        return QString(static_cast<QChar>(person->hsys));
+    case 9 :
+        return person->patch.isEmpty() ? "-" : "+";
+    default :
+        return {};
+    }
+}
+
+
+auto PersonModel::headerData(int section, Qt::Orientation orientation, int role) const -> QVariant
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole || section < 0 || section > 9)
+        return {};
+
+    return QApplication::translate("DataBaseDialog", header_[section]);
+}
+
+
+auto PersonModel::scope(const QString& sql) const -> QString
+{
+    // A running query narrows every statement to the persons matched so far
+    if (!isFiltered_)
+        return sql;
+
+    return QString(sql).replace(mask_.group, mask_.group + mask_.filter);
+}
+
+} // namespace napatahti
@@ -0,0 +1,73 @@
+#ifndef PERSONMODEL_H
+#define PERSONMODEL_H
+
+#include "Kernel/Person.h"
+#include "PagedModel.h"
+
+namespace napatahti {
+
+class PersonModel : public PagedModel<Person>
+{
+    Q_OBJECT
+
+public :
+    explicit PersonModel(SqlConnection& dbase, QObject* root=nullptr);
+
+    auto reload() -> void { reload(table_); }
+    auto reload(const QString& table) -> void;
+
+    auto getPerson(int row) const { return getRow(row); }
+    auto findRow(const QVariantMap& key) const -> int;
+    auto findRow(const Person& person) const -> int;
+    auto findPrefix(const QString& text) const -> int;
+    auto findText(const QString& text) const -> int;
+    auto setMarked(std::vector<QVariantMap> marked) -> void;
+    auto setFiltered(bool filtered) { isFiltered_ = filtered; }
+    auto isFiltered() const { return isFiltered_; }
+
+    auto columnCount(const QModelIndex& parent={}) const -> int;
+    auto data(const QModelIndex& index, int role=Qt::DisplayRole) const -> QVariant;
+    auto headerData(int section, Qt::Orientation orientation, int role=Qt::DisplayRole) const -> QVariant;
+
+public :
+    struct SqlMask {
+        QString count {"SELECT COUNT(*) FROM persons WHERE groupName=?;"};
+        QString page {"SELECT rowid, %1 AS sortKey, * FROM persons WHERE groupName=? "
+                      "ORDER BY %1 %2, rowid %2 LIMIT ? OFFSET ?;"};
+        QString seek {"SELECT rowid, %1 AS sortKey, * FROM persons WHERE groupName=? AND (%1, rowid) %3 (?, ?) "
+                      "ORDER BY %1 %2, rowid %2 LIMIT ?;"};
+        QString locate {"SELECT rowid, %1 AS sortKey FROM persons "
+                        "WHERE groupName=? AND name=? AND dateTime=? AND sex=?;"};
+        QString prefix {"SELECT rowid, %1 AS sortKey FROM persons WHERE groupName=? AND name LIKE ? ESCAPE '\\' "
+                        "ORDER BY %1 %2, rowid %2 LIMIT 1;"};
+        QString rank {"SELECT COUNT(*) FROM persons WHERE groupName=? AND (%1, rowid) %2 (?, ?);"};
+        QString search {"SELECT rowid, %1 AS sortKey FROM persons WHERE rowid = ("
+                            "SELECT p.rowid FROM persons_fts f JOIN persons p ON p.rowid = f.rowid "
+                            "WHERE persons_fts MATCH ? AND p.groupName=? "
+                            "ORDER BY bm25(persons_fts, 10.0, 1.0) LIMIT 1);"};
+        QString group {"groupName=?"};
+        QString filter {" AND id IN temp.person_match"};
+    };
+
+private :
+    QString table_;
+    std::vector<QVariantMap> marked_;
+
+    bool isIndexed_;
+    bool isFiltered_;
+
+    static const SqlMask mask_;
+    static const std::array<QString, 10> sortKey_;
+    static const std::array<const char*, 10> header_;
+    static const QStringList indexColumn_;
+
+private :
+    auto sortKey() const -> QString { return sortKey_[column_]; }
+    auto makeRow(const QSqlQuery& query) const -> Person { return Person(query, table_); }
+    auto scope(const QString& sql) const -> QString;
+    auto bindScope(QSqlQuery& query) const -> void { query.addBindValue(table_); }
+};
+
+} // namespace napatahti
+
+#endif // PERSONMODEL_H
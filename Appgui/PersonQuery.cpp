@@ -0,0 +1,469 @@
+#include "Kernel/RefBook.h"
+#include "Kernel/AstroBase.h"
+#include "Kernel/AspTable.h"
+#include "PersonQuery.h"
+
+namespace napatahti {
+
+PersonQuery::PersonQuery(const AstroBase& astroBase, const AspTable& aspTable)
+    : astroBase_ (astroBase)
+    , aspTable_ (aspTable)
+    , next_ (0)
+    , stamp_ (0)
+    , needFeatures_ (false)
+{}
+
+
+auto PersonQuery::compile(const QString& text, qint64 stamp) -> bool
+{
+    where_.clear();
+    bind_.clear();
+    error_.clear();
+    needFeatures_ = false;
+    stamp_ = stamp;
+    next_ = 0;
+
+    if (!tokenize(text))
+        return false;
+
+    where_ = parseOr();
+
+    if (error_.isEmpty() && token_[next_].kind != Token::End)
+        fail(tr("unexpected text"), token_[next_]);
+
+    if (!error_.isEmpty())
+    {
+        where_.clear();
+        bind_.clear();
+        return false;
+    }
+
+    // A negated feature term would match charts the index has not reached yet
+    if (needFeatures_)
+    {
+        where_ = mask_.indexed.arg(where_);
+        bind_.push_back(stamp_);
+    }
+
+    return true;
+}
+
+
+auto PersonQuery::tokenize(const QString& text) -> bool
+{
+    token_.clear();
+
+    auto pos (0);
+    auto size (static_cast<int>(text.size()));
+
+    while (pos < size)
+    {
+        auto ch (text[pos]);
+
+        if (ch.isSpace())
+        {
+            ++pos;
+            continue;
+        }
+
+        auto start (pos);
+
+        if (ch.isLetter() || ch == '_')
+        {
+            // Figure titles keep their hyphens, as in tau-quadrat
+            while (pos < size && (text[pos].isLetterOrNumber() || text[pos] == '_' || text[pos] == '-'))
+                ++pos;
+            token_.push_back({Token::Name, text.mid(start, pos - start), start});
+        }
+        else if (ch.isDigit() || (ch == '.' && pos + 1 < size && text[pos + 1].isDigit()))
+        {
+            while (pos < size && (text[pos].isDigit() || text[pos] == '.'))
+                ++pos;
+            token_.push_back({Token::Number, text.mid(start, pos - start), start});
+        }
+        else if (ch == '"' || ch == '\'')
+        {
+            auto end (text.indexOf(ch, pos + 1));
+            if (end < 0)
+            {
+                fail(tr("unclosed quote"), {Token::End, {}, start});
+                return false;
+            }
+            token_.push_back({Token::String, text.mid(pos + 1, end - pos - 1), start});
+            pos = end + 1;
+        }
+        else
+        {
+            auto pair (text.mid(pos, 2));
+
+            if (pair == "==" || pair == "!=" || pair == "<=" || pair == ">=" || pair == "&&" || pair == "||")
+                pos += 2;
+            else if (QString("<>!(),.").contains(ch))
+                ++pos;
+            else
+            {
+                fail(tr("unexpected character"), {Token::End, {}, start});
+                return false;
+            }
+            token_.push_back({Token::Symbol, text.mid(start, pos - start), start});
+        }
+    }
+
+    token_.push_back({Token::End, {}, size});
+
+    return true;
+}
+
+
+auto PersonQuery::parseOr() -> QString
+{
+    auto res (parseAnd());
+
+    while (error_.isEmpty() && peek("||"))
+    {
+        take();
+        res = res + " OR " + parseAnd();
+    }
+
+    return res;
+}
+
+
+auto PersonQuery::parseAnd() -> QString
+{
+    auto res (parseNot());
+
+    while (error_.isEmpty() && peek("&&"))
+    {
+        take();
+        res = res + " AND " + parseNot();
+    }
+
+    return res;
+}
+
+
+auto PersonQuery::parseNot() -> QString
+{
+    if (!peek("!"))
+        return parseTerm();
+
+    take();
+    return "NOT " + parseNot();
+}
+
+
+auto PersonQuery::parseTerm() -> QString
+{
+    auto& token (take());
+
+    if (token.kind == Token::Symbol && token.text == "(")
+    {
+        auto res (parseOr());
+        if (!error_.isEmpty() || !expect(")"))
+            return {};
+        return '(' + res + ')';
+    }
+
+    if (token.kind != Token::Name)
+        return fail(tr("a condition is expected"), token);
+
+    if (peek("("))
+        return parseCall(token);
+
+    if (peek("."))
+        return parseField(token);
+
+    if (token.text.compare("sex", Qt::CaseInsensitive) == 0)
+    {
+        auto op (parseCompare());
+        if (op.isEmpty())
+            return {};
+
+        auto& value (take());
+        auto sex (value.text.toUpper());
+
+        if (value.kind == Token::End || sex.size() != 1 || !QString("MFE").contains(sex))
+            return fail(tr("M, F or E is expected"), value);
+
+        bind_.push_back(sex[0].unicode());
+        return mask_.column.arg("sex", op);
+    }
+
+    return fail(tr("unknown name"), token);
+}
+
+
+auto PersonQuery::parseCall(const Token& name) -> QString
+{
+    auto func (name.text.toLower());
+    take();
+
+    needFeatures_ = true;
+
+    if (func == "aspect" || func == "orb")
+    {
+        auto keyA (toBody(take()));
+        if (keyA == NONE || !expect(","))
+            return {};
+
+        auto keyB (toBody(take()));
+        if (keyB == NONE || !expect(")"))
+            return {};
+
+        KeyPair key (keyA, keyB);
+
+        bind_.push_back(stamp_);
+        bind_.push_back(key.less);
+        bind_.push_back(key.more);
+
+        // A bare aspect() asks for any aspect of the pair
+        if (func == "aspect" && !compare_.contains(token_[next_].text))
+            return mask_.aspect.arg("");
+
+        auto op (parseCompare());
+        if (op.isEmpty())
+            return {};
+
+        auto value (toNumber(take()));
+        if (!error_.isEmpty())
+            return {};
+
+        bind_.push_back(value);
+        return mask_.aspect.arg(mask_.check.arg(func == "aspect" ? "asp" : "orb", op));
+    }
+
+    if (func == "cfg")
+    {
+        auto& title (take());
+
+        if (title.kind != Token::Name && title.kind != Token::String && title.kind != Token::Number)
+            return fail(tr("a figure is expected"), title);
+
+        auto ind (title.kind == Token::Number ? title.text.toInt() : aspTable_.getAspCfgInd(title.text));
+        if (ind == NONE)
+            return fail(tr("unknown figure"), title);
+
+        bind_.push_back(stamp_);
+        bind_.push_back(ind);
+
+        // Bodies after the title must all take part in the figure
+        QString member;
+        while (peek(","))
+        {
+            take();
+
+            auto key (toBody(take()));
+            if (key == NONE)
+                return {};
+
+            member += mask_.member;
+            bind_.push_back("%," + QString::number(key) + ",%");
+        }
+
+        if (!expect(")"))
+            return {};
+
+        return mask_.config.arg(member);
+    }
+
+    if (func == "core")
+    {
+        auto& method (take());
+        auto methodInd (QStringList {"globa", "schit"}.indexOf(method.text.toLower()));
+        if (methodInd < 0)
+            return fail(tr("globa or schit is expected"), method);
+
+        if (!expect(","))
+            return {};
+
+        auto& view (take());
+        auto viewInd (QStringList {"cos", "hor"}.indexOf(view.text.toLower()));
+        if (viewInd < 0)
+            return fail(tr("cos or hor is expected"), view);
+
+        if (!expect(")"))
+            return {};
+
+        auto op (parseCompare());
+        if (op.isEmpty())
+            return {};
+
+        bind_.push_back(stamp_);
+        bind_.push_back(methodInd);
+        bind_.push_back(viewInd);
+
+        // A number compares the total, a letter the type of the map
+        auto& value (take());
+        if (value.kind == Token::Number)
+        {
+            bind_.push_back(value.text.toDouble());
+            return mask_.core.arg("total", op);
+        }
+
+        if (value.kind == Token::End || value.text.size() != 1)
+            return fail(tr("a type letter or a number is expected"), value);
+
+        bind_.push_back(value.text.toUpper());
+        return mask_.core.arg("type", op);
+    }
+
+    return fail(tr("unknown function"), name);
+}
+
+
+auto PersonQuery::parseField(const Token& name) -> QString
+{
+    auto key (toBody(name));
+    if (key == NONE)
+        return {};
+
+    take();
+
+    auto& field (take());
+    auto column (field.text.toLower());
+
+    if (column != "sign" && column != "house" && column != "lon")
+        return fail(tr("sign, house or lon is expected"), field);
+
+    auto op (parseCompare());
+    if (op.isEmpty())
+        return {};
+
+    auto& token (take());
+    auto value (column == "sign" ? QVariant(toSign(token))
+              : column == "house" ? QVariant(toHouse(token))
+                                  : QVariant(toNumber(token)));
+    if (!error_.isEmpty())
+        return {};
+
+    needFeatures_ = true;
+
+    bind_.push_back(stamp_);
+    bind_.push_back(key);
+    bind_.push_back(value);
+
+    return mask_.body.arg(column == "lon" ? "crd" : column, op);
+}
+
+
+auto PersonQuery::parseCompare() -> QString
+{
+    auto& token (take());
+    auto check (compare_.find(token.text));
+
+    if (token.kind != Token::Symbol || check == compare_.end())
+        return fail(tr("a comparison is expected"), token);
+
+    return check->second;
+}
+
+
+auto PersonQuery::peek(const QString& symbol) const -> bool
+{
+    auto& token (token_[next_]);
+    return token.kind == Token::Symbol && token.text == symbol;
+}
+
+
+auto PersonQuery::take() -> const Token&
+{
+    auto& token (token_[next_]);
+
+    // The end token stays put, every later read sees it
+    if (token.kind != Token::End)
+        ++next_;
+
+    return token;
+}
+
+
+auto PersonQuery::expect(const QString& symbol) -> bool
+{
+    if (peek(symbol))
+    {
+        take();
+        return true;
+    }
+
+    fail('"' + symbol + "\" " + tr("is expected"), token_[next_]);
+    return false;
+}
+
+
+auto PersonQuery::toBody(const Token& token) -> int
+{
+    auto& catalog (astroBase_.getPlanetCatalog());
+
+    if (token.kind == Token::Number && catalog.count(token.text.toInt()) != 0)
+        return token.text.toInt();
+
+    if (token.kind == Token::Name)
+        for (auto& i : catalog)
+            if (AstroBase::getPlanetName(i.first).compare(token.text, Qt::CaseInsensitive) == 0)
+                return i.first;
+
+    fail(tr("unknown body"), token);
+    return NONE;
+}
+
+
+auto PersonQuery::toSign(const Token& token) -> int
+{
+    if (token.kind == Token::Number)
+    {
+        auto sign (token.text.toInt());
+        if (sign >= 1 && sign <= 12)
+            return sign - 1;
+    }
+
+    for (auto i (0); i < 12; ++i)
+        if (signName_[i].compare(token.text, Qt::CaseInsensitive) == 0 ||
+            RefBook::signSymStr[i].compare(token.text, Qt::CaseInsensitive) == 0)
+            return i;
+
+    fail(tr("unknown sign"), token);
+    return NONE;
+}
+
+
+auto PersonQuery::toHouse(const Token& token) -> int
+{
+    if (token.kind == Token::Number)
+    {
+        auto house (token.text.toInt());
+        if (house >= 1 && house <= 12)
+            return house - 1;
+    }
+
+    for (auto i (0); i < 12; ++i)
+        if (RefBook::houseSymStr[i].compare(token.text, Qt::CaseInsensitive) == 0)
+            return i;
+
+    fail(tr("unknown house"), token);
+    return NONE;
+}
+
+
+auto PersonQuery::toNumber(const Token& token) -> double
+{
+    auto ok (false);
+    auto value (token.text.toDouble(&ok));
+
+    if (token.kind != Token::Number || !ok)
+        fail(tr("a number is expected"), token);
+
+    return value;
+}
+
+
+auto PersonQuery::fail(const QString& error, const Token& token) -> QString
+{
+    // The first error is the one worth showing
+    if (error_.isEmpty())
+        error_ = QString::number(token.pos + 1) + " : " + error;
+
+    return {};
+}
+
+} // namespace napatahti
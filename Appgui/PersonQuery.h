@@ -0,0 +1,94 @@
+#ifndef PERSONQUERY_H
+#define PERSONQUERY_H
+
+#include <map>
+#include <QVariantList>
+#include <QCoreApplication>
+
+namespace napatahti {
+
+class AstroBase;
+class AspTable;
+
+
+class PersonQuery
+{
+    Q_DECLARE_TR_FUNCTIONS(PersonQuery)
+
+public :
+    explicit PersonQuery(const AstroBase& astroBase, const AspTable& aspTable);
+
+    auto compile(const QString& text, qint64 stamp) -> bool;
+
+    auto& getWhere() const { return where_; }
+    auto& getBind() const { return bind_; }
+    auto& getError() const { return error_; }
+    auto needFeatures() const { return needFeatures_; }
+
+public :
+    struct SqlMask {
+        QString body {"p.id IN (SELECT person FROM feature_body "
+                      "WHERE stamp=? AND body=? AND %1 %2 ?)"};
+        QString aspect {"p.id IN (SELECT person FROM feature_aspect "
+                        "WHERE stamp=? AND bodyA=? AND bodyB=?%1)"};
+        QString config {"p.id IN (SELECT person FROM feature_config "
+                        "WHERE stamp=? AND config=?%1)"};
+        QString member {" AND member LIKE ?"};
+        QString core {"p.id IN (SELECT person FROM feature_core "
+                      "WHERE stamp=? AND method=? AND view=? AND %1 %2 ?)"};
+        QString indexed {"(%1) AND p.id IN (SELECT person FROM feature_state WHERE stamp=?)"};
+        QString column {"p.%1 %2 ?"};
+        QString check {" AND %1 %2 ?"};
+    };
+
+private :
+    struct Token {
+        enum Kind {Name, Number, String, Symbol, End};
+
+        Kind    kind;
+        QString text;
+        int     pos;
+    };
+
+    const AstroBase& astroBase_;
+    const AspTable&  aspTable_;
+
+    std::vector<Token> token_;
+    std::size_t next_;
+    qint64 stamp_;
+
+    QString      where_;
+    QVariantList bind_;
+    QString      error_;
+    bool         needFeatures_;
+
+    static const SqlMask mask_;
+    static const std::array<QString, 12> signName_;
+    static const std::map<QString, QString> compare_;
+
+private :
+    auto tokenize(const QString& text) -> bool;
+
+    auto parseOr() -> QString;
+    auto parseAnd() -> QString;
+    auto parseNot() -> QString;
+    auto parseTerm() -> QString;
+    auto parseCall(const Token& name) -> QString;
+    auto parseField(const Token& name) -> QString;
+    auto parseCompare() -> QString;
+
+    auto peek(const QString& symbol) const -> bool;
+    auto take() -> const Token&;
+    auto expect(const QString& symbol) -> bool;
+
+    auto toBody(const Token& token) -> int;
+    auto toSign(const Token& token) -> int;
+    auto toHouse(const Token& token) -> int;
+    auto toNumber(const Token& token) -> double;
+
+    auto fail(const QString& error, const Token& token) -> QString;
+};
+
+} // namespace napatahti
+
+#endif // PERSONQUERY_H
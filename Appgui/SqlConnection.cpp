@@ -0,0 +1,209 @@
+#include "shared.h"
+#include "SqlConnection.h"
+
+namespace napatahti {
+
+SqlConnection::SqlConnection(const QString& connection, const QString& dbaseName)
+    : dbase_ (QSqlDatabase::addDatabase("QSQLITE", connection))
+{
+    dbase_.setDatabaseName(dbaseName);
+    dbase_.setConnectOptions("QSQLITE_BUSY_TIMEOUT=5000");
+}
+
+
+SqlConnection::~SqlConnection()
+{
+    close();
+}
+
+
+auto SqlConnection::open() -> bool
+{
+    if (dbase_.isOpen())
+        return true;
+
+    if (!dbase_.open())
+        return false;
+
+    // Settings of the connection, they live as long as it stays open
+    QSqlQuery query (dbase_);
+    for (auto& i : pragma_)
+        if (!query.exec(i))
+            errorLog("Can not set " + i + " : " + query.lastError().text());
+
+    return true;
+}
+
+
+auto SqlConnection::close() -> void
+{
+    if (!dbase_.isOpen())
+        return;
+
+    forget();
+
+    // Fold the write-ahead log back into the base on the way out
+    QSqlQuery query (dbase_);
+    query.exec("PRAGMA optimize;");
+    query.exec("PRAGMA wal_checkpoint(TRUNCATE);");
+    query.finish();
+
+    dbase_.close();
+}
+
+
+auto SqlConnection::exec(const QString& sql) -> QSqlQuery
+{
+    QSqlQuery query (dbase_);
+
+    if (!sql.isEmpty())
+        query.exec(sql);
+
+    return query;
+}
+
+
+auto SqlConnection::prepare(const QString& sql) -> QSqlQuery&
+{
+    auto check (cache_.find(sql));
+
+    if (check != cache_.end())
+    {
+        // A statement left on a result set would hold its read lock
+        check->second.finish();
+        return check->second;
+    }
+
+    QSqlQuery query (dbase_);
+    query.setForwardOnly(true);
+
+    if (!query.prepare(sql))
+        errorLog("Can not prepare " + sql + " : " + query.lastError().text());
+
+    return cache_.emplace(sql, std::move(query)).first->second;
+}
+
+
+auto SqlConnection::forget() -> void
+{
+    // Statements keep their tables locked and stop matching them
+    // after a rename, so schema changes start from a clean cache
+    cache_.clear();
+}
+
+
+auto SqlConnection::makeIndex(const QString& table, const QStringList& column) -> bool
+{
+    if (hasIndex(table))
+        return true;
+
+    forget();
+
+    auto list (column.join(", "));
+    auto oldList ("old." + column.join(", old."));
+    auto newList ("new." + column.join(", new."));
+
+    QSqlQuery query (dbase_);
+
+    // Trigrams match any substring; diacritics are folded
+    // only where the bundled SQLite is recent enough
+    auto isCreated (false);
+    for (auto& i : tokenizer_)
+        if (query.exec(indexMask_.create.arg(table, list, i)))
+        {
+            isCreated = true;
+            break;
+        }
+
+    if (!isCreated)
+    {
+        errorLog("Can not index " + table + " : " + query.lastError().text());
+        return false;
+    }
+
+    transaction();
+
+    auto resp (
+        query.exec(indexMask_.insert.arg(table, list, newList)) &&
+        query.exec(indexMask_.erase.arg(table, list, oldList)) &&
+        query.exec(indexMask_.update.arg(table, list, oldList, newList)) &&
+        query.exec(indexMask_.rebuild.arg(table)));
+
+    if (resp)
+        return commit();
+
+    errorLog("Can not index " + table + " : " + query.lastError().text());
+    rollback();
+    dropIndex(table);
+
+    return false;
+}
+
+
+auto SqlConnection::dropIndex(const QString& table) -> void
+{
+    forget();
+
+    QSqlQuery query (dbase_);
+    for (auto& i : indexMask_.drop)
+        query.exec(i.arg(table));
+}
+
+
+auto SqlConnection::hasTable(const QString& table) -> bool
+{
+    auto& query (prepare(indexMask_.exists));
+    query.addBindValue(table);
+
+    auto resp (query.exec() && query.next());
+    query.finish();
+
+    return resp;
+}
+
+
+auto SqlConnection::getVersion() -> int
+{
+    QSqlQuery query (dbase_);
+
+    if (query.exec("PRAGMA user_version;") && query.next())
+        return query.value(0).toInt();
+
+    return 0;
+}
+
+
+auto SqlConnection::setVersion(int version) -> bool
+{
+    QSqlQuery query (dbase_);
+    return query.exec(QString("PRAGMA user_version=%1;").arg(version));
+}
+
+
+auto SqlConnection::transaction() -> bool
+{
+    for (auto& i : cache_)
+        i.second.finish();
+
+    return dbase_.transaction();
+}
+
+
+auto SqlConnection::commit() -> bool
+{
+    if (dbase_.commit())
+        return true;
+
+    errorLog("Can not commit " + dbase_.databaseName() + " : " + dbase_.lastError().text());
+    dbase_.rollback();
+
+    return false;
+}
+
+
+auto SqlConnection::rollback() -> bool
+{
+    return dbase_.rollback();
+}
+
+} // namespace napatahti
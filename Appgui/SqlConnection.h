@@ -0,0 +1,74 @@
+#ifndef SQLCONNECTION_H
+#define SQLCONNECTION_H
+
+#include <map>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+
+namespace napatahti {
+
+class SqlConnection
+{
+public :
+    explicit SqlConnection(const QString& connection, const QString& dbaseName);
+    ~SqlConnection();
+
+    SqlConnection(const SqlConnection&) = delete;
+    auto operator=(const SqlConnection&) -> SqlConnection& = delete;
+
+    auto open() -> bool;
+    auto close() -> void;
+    auto isOpen() const { return dbase_.isOpen(); }
+
+    auto exec(const QString& sql="") -> QSqlQuery;
+    auto prepare(const QString& sql) -> QSqlQuery&;
+    auto forget() -> void;
+
+    auto makeIndex(const QString& table, const QStringList& column) -> bool;
+    auto dropIndex(const QString& table) -> void;
+    auto hasIndex(const QString& table) -> bool { return hasTable(table + "_fts"); }
+    auto hasTable(const QString& table) -> bool;
+
+    auto getVersion() -> int;
+    auto setVersion(int version) -> bool;
+
+    auto transaction() -> bool;
+    auto commit() -> bool;
+    auto rollback() -> bool;
+
+    auto lastError() const { return dbase_.lastError(); }
+    auto getName() const { return dbase_.databaseName(); }
+
+public :
+    struct IndexMask {
+        QString exists {"SELECT 1 FROM sqlite_master WHERE type='table' AND name=?;"};
+        QString create {"CREATE VIRTUAL TABLE %1_fts USING fts5("
+                            "%2, content='%1', content_rowid='rowid', tokenize=\"%3\");"};
+        QString insert {"CREATE TRIGGER %1_fts_ai AFTER INSERT ON %1 BEGIN "
+                            "INSERT INTO %1_fts (rowid, %2) VALUES (new.rowid, %3); END;"};
+        QString erase {"CREATE TRIGGER %1_fts_ad AFTER DELETE ON %1 BEGIN "
+                           "INSERT INTO %1_fts (%1_fts, rowid, %2) VALUES ('delete', old.rowid, %3); END;"};
+        QString update {"CREATE TRIGGER %1_fts_au AFTER UPDATE ON %1 BEGIN "
+                            "INSERT INTO %1_fts (%1_fts, rowid, %2) VALUES ('delete', old.rowid, %3); "
+                            "INSERT INTO %1_fts (rowid, %2) VALUES (new.rowid, %4); END;"};
+        QString rebuild {"INSERT INTO %1_fts (%1_fts) VALUES ('rebuild');"};
+        QStringList drop {
+            "DROP TRIGGER IF EXISTS %1_fts_ai;",
+            "DROP TRIGGER IF EXISTS %1_fts_ad;",
+            "DROP TRIGGER IF EXISTS %1_fts_au;",
+            "DROP TABLE IF EXISTS %1_fts;"};
+    };
+
+private :
+    QSqlDatabase dbase_;
+    std::map<QString, QSqlQuery> cache_;
+
+    static const QStringList pragma_;
+    static const QStringList tokenizer_;
+    static const IndexMask indexMask_;
+};
+
+} // namespace napatahti
+
+#endif // SQLCONNECTION_H
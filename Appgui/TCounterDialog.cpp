@@ -1,14 +1,22 @@
+#include "mask.h"
 #include "Kernel/Person.h"
 #include "Kernel/AstroBase.h"
 #include "SharedGui.h"
+#include "AspTimelineView.h"
 #include "TCounterDialog.h"
 #include "ui_TCounterDialog.h"
 
 namespace napatahti {
 
-TCounterDialog::TCounterDialog(Person* person, QWidget* root)
+TCounterDialog::TCounterDialog(
+    Person*          person,
+    const AstroBase& astroBase,
+    const AspPage&   aspPage,
+    QWidget*         root
+    )
     : QDialog(root)
     , ui(new Ui::TCounterDialog)
+    , timeline_ (new AspTimelineView(*person, astroBase, aspPage, this))
     , personAct_ (person)
     , personRes_ (new Person(*person))
     , epheRange_ (AstroBase::getEpheRange())
@@ -50,6 +58,11 @@ TCounterDialog::TCounterDialog(Person* person, QWidget* root)
     bgSpec->addButton(ui->resetButton);
 
     connect(bgSpec, &QButtonGroup::buttonClicked, this, &TCounterDialog::onClickSpec);
+
+    ui->timelineArea->setWidget(timeline_);
+    timeline_->setDays(ui->daysSpinBox->value());
+
+    connect(ui->daysSpinBox, &QSpinBox::valueChanged, timeline_, &AspTimelineView::setDays);
 }
 
 
@@ -105,8 +118,10 @@ void TCounterDialog::onClickStep(const QAbstractButton* button)
             personAct_->patch.clear();
     }
 
-    emit personChanged(0, 0);
+    emit personChanged(KernelMask::Cached, 0);
     emit personNeedSync();
+
+    timeline_->reload();
 }
 
 
@@ -136,14 +151,17 @@ void TCounterDialog::onClickSpec(const QAbstractButton* button)
             personAct_->patch.clear();
     }
 
-    emit personChanged(0, 0);
+    emit personChanged(KernelMask::Cached, 0);
     emit personNeedSync();
+
+    timeline_->reload();
 }
 
 
 void TCounterDialog::onDialogSync()
 {
     *personRes_ = *personAct_;
+    timeline_->reload();
 }
 
 
@@ -152,6 +170,8 @@ auto TCounterDialog::modeShow() -> void
     *personRes_ = *personAct_;
     showNormal();
     activateWindow();
+
+    timeline_->reload();
 }
 
 } // namespace napatahti
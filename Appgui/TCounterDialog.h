@@ -11,6 +11,9 @@ class TCounterDialog;
 namespace napatahti {
 
 class Person;
+class AstroBase;
+class AspPage;
+class AspTimelineView;
 
 
 class TCounterDialog : public QDialog
@@ -18,7 +21,12 @@ class TCounterDialog : public QDialog
     Q_OBJECT
 
 public :
-    explicit TCounterDialog(Person* person, QWidget* root=nullptr);
+    explicit TCounterDialog(
+        Person*          person,
+        const AstroBase& astroBase,
+        const AspPage&   aspPage,
+        QWidget*         root=nullptr);
+
     ~TCounterDialog();
 
     auto modeShow() -> void;
@@ -36,6 +44,8 @@ private :
     QButtonGroup* bgStepForw_;
     QButtonGroup* bgStepBack_;
 
+    AspTimelineView* timeline_;
+
     Person* personAct_;
     Person* personRes_;
 
@@ -201,6 +201,21 @@ auto AshaTest::update() -> void
 }
 
 
+auto AshaTest::saveState() const -> State
+{
+    return {powerKindness_, powerCreative_, kindDetailed_, ashaSpec_};
+}
+
+
+auto AshaTest::loadState(State state) -> void
+{
+    powerKindness_ = std::move(state.powerKindness);
+    powerCreative_ = std::move(state.powerCreative);
+    kindDetailed_ = std::move(state.kindDetailed);
+    ashaSpec_ = std::move(state.ashaSpec);
+}
+
+
 auto AshaTest::toStrAshaStat() const -> QString
 {
     QString str;
@@ -25,10 +25,20 @@ struct AshaSpec {
 
 class AshaTest
 {
+public :
+    struct State {
+        std::map<int, std::array<double, 2>> powerKindness;
+        std::map<int, std::array<double, 2>> powerCreative;
+        std::map<int, std::array<double, 2>> kindDetailed;
+        AshaSpec ashaSpec;
+    };
+
 public :
     explicit AshaTest(const AstroBase& astroBase) : astroBase_ (astroBase) {}
 
     auto update() -> void;
+    auto saveState() const -> State;
+    auto loadState(State state) -> void;
     auto toStrAshaStat() const -> QString;
 
     auto& getAshaSpec() const { return ashaSpec_; }
@@ -0,0 +1,181 @@
+#include <QIODevice>
+#include <QTextStream>
+#include <QDataStream>
+#include "shared.h"
+#include "AspPatch.h"
+
+namespace napatahti {
+
+auto KeyPair::operator<(const KeyPair& rhs) const -> bool
+{
+    return ((less < rhs.less) || (less == rhs.less && more < rhs.more)) ? true : false;
+}
+
+
+auto KeyPair::operator>(const KeyPair& rhs) const -> bool
+{
+    return ((less > rhs.less) || (less == rhs.less && more > rhs.more)) ? true : false;
+}
+
+
+AspData::AspData(const QString& str)
+{
+    auto chain (str.split(", "));
+
+    ang = chain[0].toDouble();
+    asp = chain[1].toDouble();
+    orb = chain[2].toDouble();
+    acc = chain[3].toInt();
+}
+
+
+AspData::operator QString() const
+{
+    QString str;
+    QTextStream out (&str);
+
+    out.setRealNumberNotation(QTextStream::FixedNotation);
+    out.setRealNumberPrecision(9);
+    out << ang << ", " << asp << ", " << orb << ", " << acc;
+
+    return str;
+}
+
+
+auto AspData::operator==(const AspData& rhs) const -> bool
+{
+    return ang == rhs.ang && asp == rhs.asp && orb == rhs.orb && acc == rhs.acc;
+}
+
+
+AspPatch::AspPatch(const QVariant& value)
+{
+    // Rows written before the binary format keep the text one
+    if (value.isNull())
+        return;
+    else if (value.typeId() == QMetaType::QByteArray)
+        *this = fromBlob(value.toByteArray());
+    else
+        *this = fromString(value.toString());
+}
+
+
+auto AspPatch::find(const KeyPair& key) const -> const AspData*
+{
+    auto check (map_.find(key));
+    return check != map_.end() ? &check->second : nullptr;
+}
+
+
+auto AspPatch::toBlob() const -> QByteArray
+{
+    if (map_.empty())
+        return {};
+
+    QByteArray res;
+    QDataStream out (&res, QIODevice::WriteOnly);
+
+    out << version_ << static_cast<quint32>(map_.size());
+
+    for (auto& i : map_)
+        out << static_cast<qint16>(i.first.less) << static_cast<qint16>(i.first.more)
+            << i.second.ang << i.second.asp << i.second.orb
+            << static_cast<qint8>(i.second.acc);
+
+    return res;
+}
+
+
+auto AspPatch::toString() const -> QString
+{
+    QStringList res;
+
+    // Doubles go out with all their digits, so the text reads back to the same patch
+    for (auto& [key, data] : map_)
+        res.push_back(QString(key) + " : " + QString("%1, %2, %3, %4")
+            .arg(data.ang, 0, 'g', 17).arg(data.asp, 0, 'g', 17).arg(data.orb, 0, 'g', 17).arg(data.acc));
+
+    auto str (res.join("; "));
+    Q_ASSERT(fromString(str) == *this);
+
+    return str;
+}
+
+
+auto AspPatch::fromBlob(const QByteArray& blob) -> AspPatch
+{
+    AspPatch res;
+
+    if (blob.isEmpty())
+        return res;
+
+    QDataStream in (blob);
+    quint8  version;
+    quint32 size;
+
+    in >> version >> size;
+
+    if (version != version_)
+    {
+        errorLog("unknown patch version " + QString::number(version));
+        return res;
+    }
+
+    for (auto i (0u); i < size; ++i)
+    {
+        qint16 less, more;
+        qint8  acc;
+        AspData data;
+
+        in >> less >> more >> data.ang >> data.asp >> data.orb >> acc;
+        data.acc = acc;
+
+        if (in.status() != QDataStream::Ok)
+        {
+            errorLog("broken patch data");
+            return {};
+        }
+
+        res.map_[{less, more}] = data;
+    }
+
+    return res;
+}
+
+
+auto AspPatch::fromString(const QString& str, bool* ok) -> AspPatch
+{
+    AspPatch res;
+
+    if (ok != nullptr)
+        *ok = true;
+
+    if (str.isEmpty())
+        return res;
+
+    // Imported text is checked, a broken pair leaves the whole patch empty
+    for (auto& i : str.split("; "))
+    {
+        auto pair (i.split(" : "));
+        auto key (pair[0].split(", "));
+        auto data (pair.size() == 2 ? pair[1].split(", ") : QStringList());
+
+        auto isValid (pair.size() == 2 && key.size() == 2 && data.size() == 4);
+        for (auto& j : key + data)
+            if (isValid)
+                j.toDouble(&isValid);
+
+        if (!isValid)
+        {
+            if (ok != nullptr)
+                *ok = false;
+            return {};
+        }
+
+        res.map_[pair[0]] = pair[1];
+    }
+
+    return res;
+}
+
+} // namespace napatahti
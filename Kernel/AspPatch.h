@@ -0,0 +1,99 @@
+#ifndef ASPPATCH_H
+#define ASPPATCH_H
+
+#include <map>
+#include <array>
+#include <QString>
+#include <QVariant>
+
+namespace napatahti {
+
+struct KeyPair {
+    KeyPair(int keyA, int keyB)
+        : less (keyA < keyB ? keyA : keyB)
+        , more (keyA < keyB ? keyB : keyA)
+    {}
+    KeyPair(const std::array<int, 2>& key)
+        : less (key[0] < key[1] ? key[0] : key[1])
+        , more (key[0] < key[1] ? key[1] : key[0])
+    {}
+    KeyPair(const QString& str)
+        : less (str.split(", ")[0].toInt())
+        , more (str.split(", ")[1].toInt())
+    {}
+
+    const int less;
+    const int more;
+
+    auto contains(int key) const { return key == less || key == more; }
+    auto other(int key) const { return key == less ? more : less; }
+    auto empty() const { return false; }
+    auto size() const { return static_cast<unsigned long long>(2); }
+    auto begin() const { return &less; }
+    auto end() const { return &more + 1; }
+
+    operator QString() const { return QString("%1, %2").arg(less).arg(more); }
+    auto operator<(const KeyPair& rhs) const -> bool;
+    auto operator>(const KeyPair& rhs) const -> bool;
+    auto operator==(const KeyPair& rhs) const { return less == rhs.less && more == rhs.more; }
+    auto operator!=(const KeyPair& rhs) const { return !operator==(rhs); };
+};
+
+
+struct AspData {
+    AspData() {}
+    AspData(double ang, double asp, double orb, int acc)
+        : ang (ang), asp (asp), orb (orb), acc (acc) {}
+    AspData(const QString& str);
+
+    double ang;
+    double asp;
+    double orb;
+    int    acc;
+
+    operator QString() const;
+    auto operator==(const AspData& rhs) const -> bool;
+    auto operator!=(const AspData& rhs) const { return !operator==(rhs); }
+};
+
+
+
+class AspPatch
+{
+public :
+    using patch_map_t = std::map<KeyPair, AspData>;
+
+    AspPatch() {}
+    explicit AspPatch(const QVariant& value);
+
+    auto isEmpty() const { return map_.empty(); }
+    auto clear() { map_.clear(); }
+
+    auto find(const KeyPair& key) const -> const AspData*;
+    auto contains(const KeyPair& key) const { return map_.find(key) != map_.end(); }
+    auto insert(const KeyPair& key, const AspData& data) { map_.insert_or_assign(key, data); }
+    auto erase(const KeyPair& key) { return map_.erase(key) != 0; }
+
+    auto begin() const { return map_.begin(); }
+    auto end() const { return map_.end(); }
+
+    auto toBlob() const -> QByteArray;
+    auto toString() const -> QString;
+
+    static auto fromBlob(const QByteArray& blob) -> AspPatch;
+    static auto fromString(const QString& str, bool* ok=nullptr) -> AspPatch;
+
+    auto operator==(const AspPatch& rhs) const { return map_ == rhs.map_; }
+    auto operator!=(const AspPatch& rhs) const { return !operator==(rhs); }
+
+private :
+    patch_map_t map_;
+
+    static constexpr quint8 version_ {1};
+};
+
+} // namespace napatahti
+
+Q_DECLARE_METATYPE(napatahti::AspPatch)
+
+#endif // ASPPATCH_H
@@ -52,22 +52,62 @@ auto AspTable::update(bool mode, int accKey, int viewKey) -> void
         computePlanetX2Table();
         computeStarTable();
         computeAspConfig();
+        computeStellium();
+    }
 
-        auto check (aspCfgTable_.find(1));
-        if (check != aspCfgTable_.end())
-        {
-            auto& planetSignNo (astroBase_.getPlanetSignNo());
-            for (auto& stellium : check->second.first)
-            {
-                std::set<int> buf;
-                for (auto j : stellium)
-                    buf.insert(planetSignNo.at(j));
+    aspCfgTable_.clear();
+    aspCfgBone_.clear();
+    aspCfgSrc_[false].clear();
+    aspCfgOffset_ = {};
 
-                aspTabSpec_.stelliumSign.push_back(std::move(buf));
-            }
+    makeSample(accKey);
+    findZeroCfg();
+
+    auto end (aspConfigEnd_[viewKey]);
+    for (auto i (2); i < end; ++i)
+        findAspCfg(i, false);
+}
+
+
+auto AspTable::updatePair(const KeyPair& key, int accKey, int viewKey) -> bool
+{
+    auto patch (person_.patch.find(key));
+    auto data (patch != nullptr ? *patch : makeAspData(key));
+
+    auto& cell (planetX2Table_.at(key));
+    if (cell == data)
+        return false;
+
+    // The cell is replaced in place, so the samples still point to it
+    cell = data;
+
+    // Chart wide pass, the same as computeAspConfig but only the bones
+    // which hold the changed pair are searched again
+    aspCfgTable_.clear();
+    aspCfgBone_.clear();
+    aspCfgOffset_ = {};
+    isMajorCfg_ = false;
+    aspTabSpec_ = {};
+
+    makeSample();
+    findZeroCfg();
+    rematchAspCfg(key, aspConfigEnd_[1], true);
+
+    for (auto i (2); i < aspConfigEnd_[1]; ++i)
+    {
+        placeAspCfg(i, true);
+        if (i == 19)
+        {
+            computeAspField();
+            computeRexAspInPit();
+            computeAspFictStat();
+            computeMapView();
         }
     }
 
+    computeStellium();
+
+    // View pass
     aspCfgTable_.clear();
     aspCfgBone_.clear();
     aspCfgOffset_ = {};
@@ -76,8 +116,12 @@ auto AspTable::update(bool mode, int accKey, int viewKey) -> void
     findZeroCfg();
 
     auto end (aspConfigEnd_[viewKey]);
+    rematchAspCfg(key, end, false);
+
     for (auto i (2); i < end; ++i)
-        findAspCfg(i, false);
+        placeAspCfg(i, false);
+
+    return true;
 }
 
 
@@ -123,16 +167,63 @@ auto AspTable::getAspSample(bool bonesOnly, QGraphicsItem* item) const -> const
 }
 
 
+auto AspTable::getAspCfgInd(const QString& title) const -> int
+{
+    // "big-trine" and "Big trine" name the same figure
+    auto key (QString(title).replace('-', ' ').simplified());
+
+    for (auto& i : srcAspConfigTable_)
+        if (QString(i.second.second->title).replace('-', ' ').compare(key, Qt::CaseInsensitive) == 0)
+            return i.first;
+
+    return NONE;
+}
+
+
+auto AspTable::saveState() const -> State
+{
+    return {
+        planetX2Table_, aspSample_, keySeqList_, planetStarTable_, cuspidStarTable_,
+        zeroMass_, aspCfgTable_, aspCfgBone_, aspCfgSrc_, aspCfgOffset_,
+        aspField_, aspFictStat_, aspTabSpec_, mapView_, isMajorCfg_
+    };
+}
+
+
+auto AspTable::loadState(State state) -> void
+{
+    planetX2Table_ = std::move(state.planetX2Table);
+    aspSample_ = std::move(state.aspSample);
+    keySeqList_ = std::move(state.keySeqList);
+    planetStarTable_ = std::move(state.planetStarTable);
+    cuspidStarTable_ = std::move(state.cuspidStarTable);
+
+    zeroMass_ = std::move(state.zeroMass);
+    aspCfgTable_ = std::move(state.aspCfgTable);
+    aspCfgBone_ = std::move(state.aspCfgBone);
+    aspCfgSrc_ = std::move(state.aspCfgSrc);
+    aspCfgOffset_ = state.aspCfgOffset;
+
+    aspField_ = state.aspField;
+    aspFictStat_ = std::move(state.aspFictStat);
+    aspTabSpec_ = std::move(state.aspTabSpec);
+    mapView_ = state.mapView;
+    isMajorCfg_ = state.isMajorCfg;
+
+    // The sample still points to the table it was copied from
+    for (auto& i : aspSample_)
+        for (auto& j : i)
+            j.second = &planetX2Table_.at(j.first);
+
+    aspSampleMarkCfg_.clear();
+}
+
+
 auto AspTable::computePlanetX2Table() -> void
 {
     planetX2Table_.clear();
 
     auto& planetCrd (astroBase_.getPlanetCrd());
-    auto& aspCatalog (aspPage_.getAspCatalog());
-    auto& orbTable (aspPage_.getOrbTable());
-
-    auto aspPatch (makePatch(person_.patch));
-    auto aspPatchEnd (aspPatch.end());
 
     for (auto& i : planetCrd)
         for (auto& j : planetCrd)
@@ -140,40 +231,11 @@ auto AspTable::computePlanetX2Table() -> void
             if (i.first >= j.first)
                 continue;
 
-            auto patch (aspPatch.find({i.first, j.first}));
-            if (patch != aspPatchEnd)
-            {
-                planetX2Table_[{i.first, j.first}] = patch->second;
-                continue;
-            }
-
-            auto ang (std::abs(i.second - j.second));
-            if (ang > 180)
-                ang = 360 - ang;
-
-            auto& cell (planetX2Table_[{i.first, j.first}]);
-            cell = {ang, NONE, NONE, NONE};
-
-            for (auto& k : aspCatalog)
-            {
-                auto orb (orbTable.get(i.first, j.first, k.first));
-                auto acc (std::make_pair(0.06375 * orb, 0.1275 * orb));
-
-                if ((k.first - orb) <= ang && ang <= (k.first + orb))
-                {
-                    cell.asp = k.first;
-                    cell.orb = std::abs(ang - k.first);
-                    if (ang >= (k.first - acc.first) && ang <= (k.first + acc.first))
-                        cell.acc = 1;
-                    else if (
-                        (ang >= (k.first + orb - acc.second) && ang <= (k.first + orb)) ||
-                        (ang >= (k.first - orb) && ang <= (k.first - orb + acc.second)))
-                        cell.acc = 2;
-                    else
-                        cell.acc = 0;
-                    break;
-                }
-            }
+            auto patch (person_.patch.find({i.first, j.first}));
+            if (patch != nullptr)
+                planetX2Table_[{i.first, j.first}] = *patch;
+            else
+                planetX2Table_[{i.first, j.first}] = makeAspData({i.first, j.first});
         }
 }
 
@@ -279,6 +341,8 @@ auto AspTable::computeAspConfig() -> void
     isMajorCfg_ = false;
     aspTabSpec_ = {};
 
+    aspCfgSrc_[true].clear();
+
     makeSample();
     findZeroCfg();
 
@@ -296,6 +360,24 @@ auto AspTable::computeAspConfig() -> void
 }
 
 
+auto AspTable::computeStellium() -> void
+{
+    auto check (aspCfgTable_.find(1));
+    if (check == aspCfgTable_.end())
+        return;
+
+    auto& planetSignNo (astroBase_.getPlanetSignNo());
+    for (auto& stellium : check->second.first)
+    {
+        std::set<int> buf;
+        for (auto j : stellium)
+            buf.insert(planetSignNo.at(j));
+
+        aspTabSpec_.stelliumSign.push_back(std::move(buf));
+    }
+}
+
+
 auto AspTable::computeAspField() -> void
 {
     aspField_ = {};
@@ -721,6 +803,43 @@ auto AspTable::addToSample(const KeyPair& key, const AspData* data) -> void
 }
 
 
+auto AspTable::makeAspData(const KeyPair& key) const -> AspData
+{
+    auto& planetCrd (astroBase_.getPlanetCrd());
+    auto& aspCatalog (aspPage_.getAspCatalog());
+    auto& orbTable (aspPage_.getOrbTable());
+
+    auto ang (std::abs(planetCrd.at(key.less) - planetCrd.at(key.more)));
+    if (ang > 180)
+        ang = 360 - ang;
+
+    AspData cell {ang, NONE, NONE, NONE};
+
+    for (auto& k : aspCatalog)
+    {
+        auto orb (orbTable.get(key.less, key.more, k.first));
+        auto acc (std::make_pair(0.06375 * orb, 0.1275 * orb));
+
+        if ((k.first - orb) <= ang && ang <= (k.first + orb))
+        {
+            cell.asp = k.first;
+            cell.orb = std::abs(ang - k.first);
+            if (ang >= (k.first - acc.first) && ang <= (k.first + acc.first))
+                cell.acc = 1;
+            else if (
+                (ang >= (k.first + orb - acc.second) && ang <= (k.first + orb)) ||
+                (ang >= (k.first - orb) && ang <= (k.first - orb + acc.second)))
+                cell.acc = 2;
+            else
+                cell.acc = 0;
+            break;
+        }
+    }
+
+    return cell;
+}
+
+
 auto AspTable::findZeroCfg() -> void
 {
     const auto& sample (aspSample_[AspGroup::Union]);
@@ -767,6 +886,13 @@ auto AspTable::findZeroCfg() -> void
 
 
 auto AspTable::findAspCfg(int ind, bool mode) -> void
+{
+    aspCfgSrc_[mode][ind] = searchAspCfg(ind, nullptr);
+    placeAspCfg(ind, mode);
+}
+
+
+auto AspTable::searchAspCfg(int ind, const std::set<int>* start) const -> std::set<bone_src_t>
 {
     const auto& data (srcAspConfigTable_.at(ind));
 
@@ -782,6 +908,9 @@ auto AspTable::findAspCfg(int ind, bool mode) -> void
 
     for (auto i : keySeq)
     {
+        if (start != nullptr && !contains(i, *start))
+            continue;
+
         auto match (std::vector<double>(pointNum, 1));
         auto bone (pointNum > 3
                        ? std::vector<int>{i, NONE, NONE, NONE}
@@ -834,7 +963,40 @@ auto AspTable::findAspCfg(int ind, bool mode) -> void
             }
     }
 
-    for (auto& bone : bones)
+    return bones;
+}
+
+
+auto AspTable::rematchAspCfg(const KeyPair& key, int end, bool mode) -> void
+{
+    auto& src (aspCfgSrc_[mode]);
+
+    for (auto i (2); i < end; ++i)
+    {
+        auto& bones (src[i]);
+
+        // Only a bone which holds both planets of the pair can depend on it
+        std::erase_if(bones, [&key](const bone_src_t& bone) {
+            return isInclude(key, bone.first);
+        });
+
+        // Bones are complete graphs, so any bone with the pair starts either
+        // from the pair itself or from a planet linked to it in the sample
+        std::set<int> start {key.less, key.more};
+        for (auto& j : aspSample_[srcAspConfigTable_.at(i).second->aspGroup])
+            if (j.first.contains(key.less))
+                start.insert(j.first.other(key.less));
+
+        for (auto& bone : searchAspCfg(i, &start))
+            if (isInclude(key, bone.first))
+                bones.insert(bone);
+    }
+}
+
+
+auto AspTable::placeAspCfg(int ind, bool mode) -> void
+{
+    for (auto& bone : aspCfgSrc_[mode][ind])
     {
         std::set<int> mass;
         for (auto i : bone.first)
@@ -1176,37 +1338,6 @@ auto AspTable::dumpExtCfg(int ind) const -> void
 }
 
 
-auto AspTable::makePatch(const std::map<KeyPair, AspData>& patch) -> QString
-{
-    if (patch.empty())
-        return {};
-
-    QString res;
-
-    for (auto i (patch.begin()), j (--patch.end()); i != patch.end(); ++i)
-        res += i->first + " : " + i->second + (i != j ? "; " : "");
-
-    return res;
-}
-
-
-auto AspTable::makePatch(const QString& patch) -> std::map<KeyPair, AspData>
-{
-    if (patch.isEmpty())
-        return {};
-
-    std::map<KeyPair, AspData> res;
-
-    for (auto& i : patch.split("; "))
-    {
-        auto pair (i.split(" : "));
-        res[pair[0]] = pair[1];
-    }
-
-    return res;
-}
-
-
 auto AspTable::getAspGroupInd(double asp) -> int
 {
     switch (static_cast<int>(asp)) {
@@ -1244,46 +1375,4 @@ auto AspTable::getAspGroupInd(double asp) -> int
     }
 }
 
-
-auto KeyPair::operator<(const KeyPair& rhs) const -> bool
-{
-    return ((less < rhs.less) || (less == rhs.less && more < rhs.more)) ? true : false;
-}
-
-
-auto KeyPair::operator>(const KeyPair& rhs) const -> bool
-{
-    return ((less > rhs.less) || (less == rhs.less && more > rhs.more)) ? true : false;
-}
-
-
-AspData::AspData(const QString& str)
-{
-    auto chain (str.split(", "));
-
-    ang = chain[0].toDouble();
-    asp = chain[1].toDouble();
-    orb = chain[2].toDouble();
-    acc = chain[3].toInt();
-}
-
-
-AspData::operator QString() const
-{
-    QString str;
-    QTextStream out (&str);
-
-    out.setRealNumberNotation(QTextStream::FixedNotation);
-    out.setRealNumberPrecision(9);
-    out << ang << ", " << asp << ", " << orb << ", " << acc;
-
-    return str;
-}
-
-
-auto AspData::operator==(const AspData& rhs) const -> bool
-{
-    return ang == rhs.ang && asp == rhs.asp && orb == rhs.orb && acc == rhs.acc;
-}
-
 } // namespace napatahti
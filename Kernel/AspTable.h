@@ -3,6 +3,7 @@
 
 #include <set>
 #include <QGraphicsItem>
+#include "AspPatch.h"
 
 namespace napatahti {
 
@@ -12,55 +13,6 @@ class AspPage;
 class ConfigDialog;
 
 
-struct KeyPair {
-    KeyPair(int keyA, int keyB)
-        : less (keyA < keyB ? keyA : keyB)
-        , more (keyA < keyB ? keyB : keyA)
-    {}
-    KeyPair(const std::array<int, 2>& key)
-        : less (key[0] < key[1] ? key[0] : key[1])
-        , more (key[0] < key[1] ? key[1] : key[0])
-    {}
-    KeyPair(const QString& str)
-        : less (str.split(", ")[0].toInt())
-        , more (str.split(", ")[1].toInt())
-    {}
-
-    const int less;
-    const int more;
-
-    auto contains(int key) const { return key == less || key == more; }
-    auto other(int key) const { return key == less ? more : less; }
-    auto empty() const { return false; }
-    auto size() const { return static_cast<unsigned long long>(2); }
-    auto begin() const { return &less; }
-    auto end() const { return &more + 1; }
-
-    operator QString() const { return QString("%1, %2").arg(less).arg(more); }
-    auto operator<(const KeyPair& rhs) const -> bool;
-    auto operator>(const KeyPair& rhs) const -> bool;
-    auto operator==(const KeyPair& rhs) const { return less == rhs.less && more == rhs.more; }
-    auto operator!=(const KeyPair& rhs) const { return !operator==(rhs); };
-};
-
-
-struct AspData {
-    AspData() {}
-    AspData(double ang, double asp, double orb, int acc)
-        : ang (ang), asp (asp), orb (orb), acc (acc) {}
-    AspData(const QString& str);
-
-    double ang;
-    double asp;
-    double orb;
-    int    acc;
-
-    operator QString() const;
-    auto operator==(const AspData& rhs) const -> bool;
-    auto operator!=(const AspData& rhs) const { return !operator==(rhs); }
-};
-
-
 struct AspGroup {
     enum {
         Union, Black, Red, Green, Blue, Violet,
@@ -131,17 +83,44 @@ public :
     using asp_cfg_seq_t = std::set<std::vector<int>>;
     using asp_config_table_t = std::map<int, std::pair<asp_cfg_seq_t, const AspCfgData*>>;
     using asp_config_bone_t = std::map<std::vector<int>, std::pair<std::vector<int>, double>>;
+    using asp_config_src_t = std::array<std::map<int, std::set<bone_src_t>>, 2>;
 
     using asp_field_t = std::array<std::pair<double, int>, 5>;
     using map_view_link_t = std::vector<std::pair<double, int>>;
     using map_view_chain_t = std::vector<map_view_link_t>;
 
+    struct State {
+        std::map<KeyPair, AspData> planetX2Table;
+        asp_sample_t               aspSample;
+        std::vector<std::set<int>> keySeqList;
+        planet_star_table_t        planetStarTable;
+        cuspid_star_table_t        cuspidStarTable;
+
+        std::set<std::set<int>> zeroMass;
+        asp_config_table_t      aspCfgTable;
+        asp_config_bone_t       aspCfgBone;
+        asp_config_src_t        aspCfgSrc;
+        std::array<int, 2>      aspCfgOffset;
+
+        asp_field_t aspField;
+        AspFictStat aspFictStat;
+        AspTabSpec  aspTabSpec;
+
+        int  mapView;
+        bool isMajorCfg;
+    };
+
 public :
     explicit AspTable(const Person& person, const AstroBase& astroBase, const AspPage& aspPage);
 
     auto update(bool mode, int accKey, int viewKey) -> void;
+    auto updatePair(const KeyPair& key, int accKey, int viewKey) -> bool;
     auto computeStarTable() -> void;
     auto getAspSample(bool bonesOnly, QGraphicsItem* item=nullptr) const -> const asp_sample_t&;
+    auto getAspCfgInd(const QString& title) const -> int;
+
+    auto saveState() const -> State;
+    auto loadState(State state) -> void;
 
     auto& aspTable() const { return *this; }
 
@@ -157,9 +136,6 @@ public :
     auto& getAspFictStat() const { return aspFictStat_; }
     auto& getAspTabSpec() const { return aspTabSpec_; }
 
-    static auto makePatch(const std::map<KeyPair, AspData>& patch) -> QString;
-    static auto makePatch(const QString& patch) -> std::map<KeyPair, AspData>;
-
 public :
     static const AspGroup aspGroup;
 
@@ -183,6 +159,7 @@ private :
     std::set<std::set<int>> zeroMass_;
     asp_config_table_t      aspCfgTable_;
     asp_config_bone_t       aspCfgBone_;
+    asp_config_src_t        aspCfgSrc_;
     std::array<int, 2>      aspCfgOffset_;
 
     asp_field_t aspField_;
@@ -205,6 +182,7 @@ private :
 private :
     auto computePlanetX2Table() -> void;
     auto computeAspConfig() -> void;
+    auto computeStellium() -> void;
     auto computeAspField() -> void;
     auto computeRexAspInPit() -> void;
     auto computeAspFictStat() -> void;
@@ -213,9 +191,13 @@ private :
     auto makeSample() -> void;
     auto makeSample(int accKey) -> void;
     auto addToSample(const KeyPair& key, const AspData* data) -> void;
+    auto makeAspData(const KeyPair& key) const -> AspData;
 
     auto findZeroCfg() -> void;
     auto findAspCfg(int ind, bool mode) -> void;
+    auto searchAspCfg(int ind, const std::set<int>* start) const -> std::set<bone_src_t>;
+    auto rematchAspCfg(const KeyPair& key, int end, bool mode) -> void;
+    auto placeAspCfg(int ind, bool mode) -> void;
     auto makeAspCfg(int ind, const std::set<int>& mass, const bone_src_t& bone, bool mode) -> void;
     auto setAspCfgOffset(const std::vector<int> &cfg, int ind) -> void;
 
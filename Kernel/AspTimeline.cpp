@@ -0,0 +1,306 @@
+#include "swelib/src/swephexp.h"
+#include "shared.h"
+#include "AstroBase.h"
+#include "AspTimeline.h"
+
+namespace napatahti {
+
+auto AspTimelineSrc::operator==(const AspTimelineSrc& rhs) const -> bool
+{
+    return
+        planet == rhs.planet &&
+        asp == rhs.asp &&
+        orbTable.planet == rhs.orbTable.planet &&
+        orbTable.asteroid == rhs.orbTable.asteroid;
+}
+
+
+auto AspTimeline::setSource(const AspTimelineSrc& src) -> bool
+{
+    if (src == src_)
+        return false;
+
+    src_ = src;
+    clear();
+
+    return true;
+}
+
+
+auto AspTimeline::missing(const range_t& range) -> std::vector<range_t>
+{
+    if (range_[0] == NONE || range[1] < range_[0] || range[0] > range_[1])
+    {
+        clear();
+        return {range};
+    }
+
+    std::vector<range_t> chunk;
+
+    if (range[0] < range_[0])
+        chunk.push_back({range[0], range_[0]});
+    if (range[1] > range_[1])
+        chunk.push_back({range_[1], range[1]});
+
+    return chunk;
+}
+
+
+auto AspTimeline::merge(const range_t& range, const span_table_t& table) -> void
+{
+    for (auto& i : table)
+    {
+        auto& list (spanTable_[i.first]);
+
+        for (auto& span : i.second)
+        {
+            auto check (std::find_if(list.begin(), list.end(), [&span](const AspSpan& item) {
+                return
+                    item.asp == span.asp &&
+                    item.begin <= span.end + accuracy_ &&
+                    span.begin <= item.end + accuracy_;
+            }));
+
+            if (check == list.end())
+            {
+                list.push_back(span);
+                continue;
+            }
+
+            check->begin = std::min(check->begin, span.begin);
+            check->end = std::max(check->end, span.end);
+
+            if (span.orb < check->orb)
+            {
+                check->exact = span.exact;
+                check->orb = span.orb;
+            }
+        }
+
+        std::sort(list.begin(), list.end(), [](const AspSpan& lhs, const AspSpan& rhs) {
+            return lhs.begin < rhs.begin;
+        });
+    }
+
+    if (range_[0] == NONE)
+        range_ = range;
+    else
+        range_ = {std::min(range_[0], range[0]), std::max(range_[1], range[1])};
+}
+
+
+auto AspTimeline::trim(const range_t& range) -> void
+{
+    if (range_[0] == NONE || range[1] < range_[0] || range[0] > range_[1])
+    {
+        clear();
+        return;
+    }
+
+    range_ = {std::max(range_[0], range[0]), std::min(range_[1], range[1])};
+
+    for (auto i (spanTable_.begin()); i != spanTable_.end(); )
+    {
+        std::erase_if(i->second, [&range](const AspSpan& item) {
+            return item.end < range[0] || item.begin > range[1];
+        });
+
+        if (i->second.empty())
+            i = spanTable_.erase(i);
+        else
+            ++i;
+    }
+}
+
+
+auto AspTimeline::clear() -> void
+{
+    spanTable_.clear();
+    range_ = {NONE, NONE};
+}
+
+
+auto AspTimeline::sweep(const AspTimelineSrc& src, const range_t& range) -> span_table_t
+{
+    struct State {
+        bool    inside {false};
+        AspSpan span;
+    };
+
+    // Swiss ephemeris keeps its settings per thread
+    AstroBase::setEphePath();
+
+    std::vector<KeyPair> pair;
+    for (auto i (src.planet.begin()); i != src.planet.end(); ++i)
+        for (auto j (i + 1); j != src.planet.end(); ++j)
+            pair.emplace_back(*i, *j);
+
+    std::vector<std::vector<double>> orb;
+    for (auto& i : pair)
+    {
+        orb.emplace_back();
+        for (auto j : src.asp)
+            orb.back().push_back(src.orbTable.get(i.less, i.more, j));
+    }
+
+    auto getDev = [](const KeyPair& key, double asp, double julDay) {
+        return std::abs(getAng(getCrd(key.less, julDay)[0], getCrd(key.more, julDay)[0]) - asp);
+    };
+
+    span_table_t table;
+    std::vector<std::vector<State>> state (pair.size(), std::vector<State>(src.asp.size()));
+    std::map<int, std::array<double, 2>> crd;
+    std::vector<double> ang (pair.size());
+
+    auto prev (range[0]);
+    auto julDay (range[0]);
+
+    while (true)
+    {
+        for (auto i : src.planet)
+            crd[i] = getCrd(i, julDay);
+
+        // The step is bounded by the time the fastest pair needs to reach
+        // the nearest orb edge, so no window can open and close unnoticed.
+        auto step (maxStep_);
+
+        for (auto i (0u); i < pair.size(); ++i)
+        {
+            auto& crdA (crd.at(pair[i].less));
+            auto& crdB (crd.at(pair[i].more));
+            auto  speed (std::abs(crdA[1] - crdB[1]));
+
+            ang[i] = getAng(crdA[0], crdB[0]);
+
+            if (speed == 0)
+                continue;
+
+            for (auto j (0u); j < src.asp.size(); ++j)
+                step = std::min(
+                    step, 0.5 * std::abs(std::abs(ang[i] - src.asp[j]) - orb[i][j]) / speed);
+        }
+
+        auto next (std::min(julDay + std::max(step, minStep_), range[1]));
+
+        for (auto i (0u); i < pair.size(); ++i)
+            for (auto j (0u); j < src.asp.size(); ++j)
+            {
+                auto& cell (state[i][j]);
+                auto  asp (src.asp[j]);
+                auto  dev (std::abs(ang[i] - asp));
+                auto  inside (dev <= orb[i][j]);
+
+                if (inside != cell.inside)
+                {
+                    auto edge (julDay);
+
+                    if (julDay != range[0])
+                    {
+                        auto lo (prev);
+                        auto hi (julDay);
+
+                        while (hi - lo > accuracy_)
+                        {
+                            auto mid (0.5 * (lo + hi));
+                            if ((getDev(pair[i], asp, mid) <= orb[i][j]) == cell.inside)
+                                lo = mid;
+                            else
+                                hi = mid;
+                        }
+
+                        edge = 0.5 * (lo + hi);
+                    }
+
+                    if (inside)
+                        cell.span = {asp, edge, edge, julDay, dev};
+                    else
+                    {
+                        cell.span.end = edge;
+                        table[pair[i]].push_back(cell.span);
+                    }
+
+                    cell.inside = inside;
+                }
+                else if (inside && dev < cell.span.orb)
+                {
+                    cell.span.exact = julDay;
+                    cell.span.orb = dev;
+                }
+            }
+
+        if (julDay == range[1])
+            break;
+
+        prev = julDay;
+        julDay = next;
+    }
+
+    for (auto i (0u); i < pair.size(); ++i)
+        for (auto& cell : state[i])
+            if (cell.inside)
+            {
+                cell.span.end = range[1];
+                table[pair[i]].push_back(cell.span);
+            }
+
+    // Refine the exact moment around the closest sample of every span
+    for (auto i (0u); i < pair.size(); ++i)
+    {
+        auto check (table.find(pair[i]));
+        if (check == table.end())
+            continue;
+
+        for (auto& span : check->second)
+        {
+            auto lo (std::max(span.begin, span.exact - maxStep_));
+            auto hi (std::min(span.end, span.exact + maxStep_));
+
+            while (hi - lo > accuracy_)
+            {
+                auto m1 (lo + (hi - lo) / 3);
+                auto m2 (hi - (hi - lo) / 3);
+
+                if (getDev(pair[i], span.asp, m1) < getDev(pair[i], span.asp, m2))
+                    hi = m2;
+                else
+                    lo = m1;
+            }
+
+            auto exact (0.5 * (lo + hi));
+            auto dev (getDev(pair[i], span.asp, exact));
+
+            if (dev < span.orb)
+            {
+                span.exact = exact;
+                span.orb = dev;
+            }
+        }
+    }
+
+    return table;
+}
+
+
+auto AspTimeline::getCrd(int key, double julDay) -> std::array<double, 2>
+{
+    int    flag (SEFLG_SWIEPH | SEFLG_SPEED);
+    double res[6];
+    char   serr[AS_MAXCH];
+
+    if (swe_calc_ut(julDay, key == 24 ? 11 : key, flag, res, serr) < 0)
+        errorLog("sweph error: " + QString(serr));
+
+    if (key == 24)
+        res[0] = res[0] < 180 ? res[0] + 180 : res[0] - 180;
+
+    return {res[0], res[3]};
+}
+
+
+auto AspTimeline::getAng(double crdA, double crdB) -> double
+{
+    auto ang (std::abs(crdA - crdB));
+    return ang > 180 ? 360 - ang : ang;
+}
+
+} // namespace napatahti
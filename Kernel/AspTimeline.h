@@ -0,0 +1,66 @@
+#ifndef ASPTIMELINE_H
+#define ASPTIMELINE_H
+
+#include "RefBook.h"
+#include "AspPage.h"
+#include "AspTable.h"
+
+namespace napatahti {
+
+struct AspSpan {
+    double asp;
+    double begin;
+    double end;
+    double exact;
+    double orb;
+};
+
+
+struct AspTimelineSrc {
+    std::vector<int>    planet;
+    std::vector<double> asp;
+    OrbTable            orbTable;
+
+    auto operator==(const AspTimelineSrc& rhs) const -> bool;
+    auto operator!=(const AspTimelineSrc& rhs) const { return !operator==(rhs); }
+};
+
+
+class AspTimeline
+{
+public :
+    using span_table_t = std::map<KeyPair, std::vector<AspSpan>>;
+    using range_t = std::array<double, 2>;
+
+public :
+    explicit AspTimeline() : range_ {NONE, NONE} {}
+
+    auto setSource(const AspTimelineSrc& src) -> bool;
+    auto missing(const range_t& range) -> std::vector<range_t>;
+    auto merge(const range_t& range, const span_table_t& table) -> void;
+    auto trim(const range_t& range) -> void;
+    auto clear() -> void;
+
+    auto& getSource() const { return src_; }
+    auto& getSpanTable() const { return spanTable_; }
+    auto& getRange() const { return range_; }
+
+    static auto sweep(const AspTimelineSrc& src, const range_t& range) -> span_table_t;
+
+private :
+    AspTimelineSrc src_;
+    span_table_t   spanTable_;
+    range_t        range_;
+
+    static constexpr double minStep_ {1 / 24.0};
+    static constexpr double maxStep_ {1.0};
+    static constexpr double accuracy_ {1 / 1440.0};
+
+private :
+    static auto getCrd(int key, double julDay) -> std::array<double, 2>;
+    static auto getAng(double crdA, double crdB) -> double;
+};
+
+} // namespace napatahti
+
+#endif // ASPTIMELINE_H
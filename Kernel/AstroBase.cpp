@@ -13,7 +13,7 @@ namespace napatahti {
 AstroBase::AstroBase(const Person& person) : person_ (person)
 {
     setEpheRange();
-    swe_set_ephe_path(path_);
+    setEphePath();
 
     auto date (QDate::currentDate());
     auto time (QTime::currentTime());
@@ -44,6 +44,44 @@ auto AstroBase::update(int space, const QLocale& locale) -> void
 }
 
 
+auto AstroBase::saveState() const -> State
+{
+    return {
+        planetCrd_, planetSpeed_, planetSignNo_, planetDegree_, planetSpeedSym_,
+        planetHouseNo_, planetCrdStr_, planetOrder_, normalizeCrd_,
+        cuspidCrd_, cuspidSignNo_, cuspidDegree_, cuspidCrdStr_, houseLength_,
+        jyotCal_, westCal_, jyotCache_, westCache_, julDay_
+    };
+}
+
+
+auto AstroBase::loadState(State state) -> void
+{
+    planetCrd_ = std::move(state.planetCrd);
+    planetSpeed_ = std::move(state.planetSpeed);
+    planetSignNo_ = std::move(state.planetSignNo);
+    planetDegree_ = std::move(state.planetDegree);
+    planetSpeedSym_ = std::move(state.planetSpeedSym);
+    planetHouseNo_ = std::move(state.planetHouseNo);
+    planetCrdStr_ = std::move(state.planetCrdStr);
+    planetOrder_ = std::move(state.planetOrder);
+    normalizeCrd_ = std::move(state.normalizeCrd);
+
+    cuspidCrd_ = state.cuspidCrd;
+    cuspidSignNo_ = state.cuspidSignNo;
+    cuspidDegree_ = state.cuspidDegree;
+    cuspidCrdStr_ = std::move(state.cuspidCrdStr);
+    houseLength_ = state.houseLength;
+
+    jyotCal_ = std::move(state.jyotCal);
+    westCal_ = std::move(state.westCal);
+    jyotCache_ = std::move(state.jyotCache);
+    westCache_ = std::move(state.westCache);
+
+    julDay_ = state.julDay;
+}
+
+
 auto AstroBase::computeHouses() -> void
 {
     cuspidCrd_    = {};
@@ -568,7 +606,7 @@ auto AstroBase::getMoonJulDay(int rev, int day, double acc) const -> double
 }
 
 
-auto AstroBase::revJulDay(double jujDay, int utc) const -> QDateTime
+auto AstroBase::revJulDay(double jujDay, int utc) -> QDateTime
 {
     int yy, mn, dd;
     double hour;
@@ -583,6 +621,12 @@ auto AstroBase::revJulDay(double jujDay, int utc) const -> QDateTime
 }
 
 
+auto AstroBase::setEphePath() -> void
+{
+    swe_set_ephe_path(path_);
+}
+
+
 auto AstroBase::loadCatalog() -> void
 {
     QFile file ("catalog.json");
@@ -22,6 +22,32 @@ class AstroBase
     using planet_string_t = std::map<int, std::array<QString, 2>>;
     using cuspid_string_t = std::array<std::array<QString, 2>, 12>;
 
+public :
+    struct State {
+        std::map<int, double>  planetCrd;
+        std::map<int, double>  planetSpeed;
+        std::map<int, int>     planetSignNo;
+        std::map<int, int>     planetDegree;
+        std::map<int, QChar>   planetSpeedSym;
+        std::map<int, int>     planetHouseNo;
+        planet_string_t        planetCrdStr;
+        std::vector<int>       planetOrder;
+        std::map<int, double>  normalizeCrd;
+
+        std::array<double, 12> cuspidCrd;
+        std::array<int, 12>    cuspidSignNo;
+        std::array<int, 12>    cuspidDegree;
+        cuspid_string_t        cuspidCrdStr;
+        std::array<double, 12> houseLength;
+
+        std::map<int, double> jyotCal;
+        std::map<int, double> westCal;
+        QStringList           jyotCache;
+        QStringList           westCache;
+
+        double julDay;
+    };
+
 public :
     explicit AstroBase(const Person& person);
 
@@ -35,6 +61,9 @@ public :
     auto computeCoupling(int space) -> void;
     auto dumpCatalog() const -> void;
 
+    auto saveState() const -> State;
+    auto loadState(State state) -> void;
+
     auto getJulDay() const { return julDay_; }
 
     auto& astroBase() { return *this; }
@@ -59,6 +88,8 @@ public :
     auto& getCuspidCrdStr() const { return cuspidCrdStr_; }
 
     static auto getPlanetName(int key) -> QString;
+    static auto revJulDay(double jujDay, int utc) -> QDateTime;
+    static auto setEphePath() -> void;
     static auto getEpheRange() -> const std::array<QDateTime, 2>& { return epheRange_; }
 
 public :
@@ -74,8 +105,6 @@ protected :
     QStringList jyotCache_;
     QStringList westCache_;
 
-    auto  revJulDay(double jujDay, int utc) const -> QDateTime;
-
 private :
     const Person& person_;
 
@@ -25,6 +25,23 @@ auto CosmicTest::update() -> void
 }
 
 
+auto CosmicTest::saveState() const -> State
+{
+    return {summary_, detailed_, cosmicSum_, recepTree_, cosmicSpec_, planetChain_};
+}
+
+
+auto CosmicTest::loadState(State state) -> void
+{
+    summary_ = std::move(state.summary);
+    detailed_ = std::move(state.detailed);
+    cosmicSum_ = state.cosmicSum;
+    recepTree_ = std::move(state.recepTree);
+    cosmicSpec_ = std::move(state.cosmicSpec);
+    planetChain_ = std::move(state.planetChain);
+}
+
+
 auto CosmicTest::toStrCosmicStat() const -> QString
 {
     QString str;
@@ -65,12 +65,23 @@ class CosmicTest
 public :
     using planet_chain_t = std::array<std::vector<std::set<int>>, 4>;
 
+    struct State {
+        std::map<int, std::array<double, 2>> summary;
+        std::map<int, std::array<double, 2>> detailed;
+        double         cosmicSum;
+        RecepTree      recepTree;
+        CosmicSpec     cosmicSpec;
+        planet_chain_t planetChain;
+    };
+
 public :
     explicit CosmicTest(const AstroBase& astroBase, const AspTable& aspTable)
         : astroBase_ (astroBase), aspTable_ (aspTable)
     {}
 
     auto update() -> void;
+    auto saveState() const -> State;
+    auto loadState(State state) -> void;
     auto toStrCosmicStat() const -> QString;
 
     auto  getCosmicSum() const { return cosmicSum_; }
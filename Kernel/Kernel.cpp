@@ -18,13 +18,10 @@ Kernel::Kernel()
     , CosmicTest (astroBase(), aspTable())
     , trigger_ (MainWindow::getTrigger())
     , locale_ (SharedGui::getAppLocale())
+    , cacheHeld_ (false)
 {
     setHeaderStr();
-    AstroBase::update(Canvas::getPlanetSpace(), locale_);
-    AspTable::update(true, getAccKey(), trigger_.aspCfgClassOnly);
-    PrimeTest::update();
-    AshaTest::update();
-    CosmicTest::update();
+    updateChart(Canvas::getPlanetSpace(), trigger_.aspCfgClassOnly);
 }
 
 
@@ -119,6 +116,172 @@ auto Kernel::getAccKey() const -> int
 }
 
 
+auto Kernel::updateChart(int space, int viewKey, bool full) -> void
+{
+    // Everything computed from the person, the tests are left out when only features are needed
+    AstroBase::update(space, locale_);
+    AspTable::update(true, getAccKey(), viewKey);
+    PrimeTest::update();
+
+    if (!full)
+        return;
+
+    AshaTest::update();
+    CosmicTest::update();
+}
+
+
+auto Kernel::loadCache(int space, int viewKey) -> bool
+{
+    if (cacheHeld_)
+        return false;
+
+    auto state (cache_.find({person(), space, getAccKey(), viewKey}));
+    if (state == nullptr)
+        return false;
+
+    loadState(*state);
+    return true;
+}
+
+
+auto Kernel::saveCache(int space, int viewKey) -> void
+{
+    if (cacheHeld_)
+        return;
+
+    cache_.insert({person(), space, getAccKey(), viewKey}, makeState());
+}
+
+
+auto Kernel::prefetch(const Person& person, int space, int viewKey) -> void
+{
+    if (cacheHeld_ || KernelCache::getCapacity() == 0)
+        return;
+
+    KernelCacheKey key (person, space, getAccKey(), viewKey);
+    if (cache_.contains(key))
+        return;
+
+    // The chart is computed in place, the current one is put back afterwards
+    auto backup (this->person());
+    auto state (makeState());
+
+    this->person() = person;
+    updateChart(space, viewKey);
+
+    cache_.insert(key, makeState());
+
+    this->person() = std::move(backup);
+    loadState(std::move(state));
+}
+
+
+auto Kernel::computeFeatures(const std::vector<Person>& person, int space, int viewKey) -> std::vector<ChartFeatures>
+{
+    std::vector<ChartFeatures> res;
+    res.reserve(person.size());
+
+    // The charts are computed in place, the current one is put back afterwards
+    auto backup (this->person());
+    auto state (makeState());
+
+    for (auto& i : person)
+    {
+        this->person() = i;
+        updateChart(space, viewKey, false);
+
+        res.push_back(makeFeatures());
+    }
+
+    this->person() = std::move(backup);
+    loadState(std::move(state));
+
+    return res;
+}
+
+
+auto Kernel::getFeatureStamp(int space, int viewKey) const -> qint64
+{
+    // Everything a stored feature depends on besides the person
+    auto seed (qHashMulti(0, AspPage::getTitle(), space, getAccKey(), viewKey));
+    auto& orb (getOrbTable());
+
+    for (auto& i : getAspEnb())
+        seed = qHashMulti(seed, i.first, i.second);
+    for (auto& i : orb.planet)
+        seed = qHashMulti(seed, i.first.first, i.first.second, i.second);
+    for (auto& i : orb.asteroid)
+        seed = qHashMulti(seed, i.first, i.second);
+    for (auto& i : orb.cuspid)
+        seed = qHashMulti(seed, i.first, i.second);
+    for (auto i : orb.star)
+        seed = qHashMulti(seed, i);
+
+    for (auto& i : getPlanetCatalog())
+        seed = qHashMulti(seed, i.first, i.second);
+    for (auto& i : getPlanetEnb())
+        seed = qHashMulti(seed, i.first, i.second.crd, i.second.asp);
+
+    return static_cast<qint64>(seed);
+}
+
+
+auto Kernel::makeState() const -> KernelState
+{
+    return {
+        AstroBase::saveState(), AspTable::saveState(), PrimeTest::saveState(),
+        AshaTest::saveState(), CosmicTest::saveState()};
+}
+
+
+auto Kernel::loadState(KernelState state) -> void
+{
+    AstroBase::loadState(std::move(state.astroBase));
+    AspTable::loadState(std::move(state.aspTable));
+    PrimeTest::loadState(std::move(state.primeTest));
+    AshaTest::loadState(std::move(state.ashaTest));
+    CosmicTest::loadState(std::move(state.cosmicTest));
+}
+
+
+auto Kernel::makeFeatures() const -> ChartFeatures
+{
+    ChartFeatures res;
+    auto& sign (getPlanetSignNo());
+    auto& house (getPlanetHouseNo());
+
+    for (auto& i : getPlanetCrd())
+    {
+        auto signNo (sign.find(i.first));
+        auto houseNo (house.find(i.first));
+
+        res.body.push_back({
+            i.first, i.second,
+            signNo != sign.end() ? signNo->second : NONE,
+            houseNo != house.end() ? houseNo->second : NONE});
+    }
+
+    // Only the aspects the map would draw
+    for (auto& i : getPlanetX2Table())
+        if (i.second.asp != NONE && getAspEnb().at(i.second.asp))
+            res.aspect.push_back({i.first.less, i.first.more, i.second.asp, i.second.orb, i.second.acc});
+
+    for (auto& i : getAspCfgTable())
+        for (auto& j : i.second.first)
+            res.config.push_back({i.first, j});
+
+    for (auto method : {0, 1})
+        for (auto view : {0, 1})
+        {
+            auto& core (coreStat_.get(method, view));
+            res.core.push_back({method, view, core.type, core.total});
+        }
+
+    return res;
+}
+
+
 auto Kernel::getCoreForce(int view) const -> const CoreForce&
 {
     if (trigger_.modeSchit)
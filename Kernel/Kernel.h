@@ -9,12 +9,45 @@
 #include "PrimeTest.h"
 #include "AshaTest.h"
 #include "CosmicTest.h"
+#include "KernelCache.h"
 
 namespace napatahti {
 
 class AppTrigger;
 
 
+struct ChartFeatures {
+    struct Body {
+        int    key;
+        double crd;
+        int    sign;
+        int    house;
+    };
+    struct Aspect {
+        int    less;
+        int    more;
+        double asp;
+        double orb;
+        int    acc;
+    };
+    struct Config {
+        int              type;
+        std::vector<int> member;
+    };
+    struct Core {
+        int    method;
+        int    view;
+        QChar  type;
+        double total;
+    };
+
+    std::vector<Body>   body;
+    std::vector<Aspect> aspect;
+    std::vector<Config> config;
+    std::vector<Core>   core;
+};
+
+
 class Kernel
     : public Person
     , public AstroBase
@@ -34,6 +67,16 @@ public :
     auto toStrMoonCalendar() const -> QString;
 
     auto getAccKey() const -> int;
+    auto updateChart(int space, int viewKey, bool full=true) -> void;
+
+    auto loadCache(int space, int viewKey) -> bool;
+    auto saveCache(int space, int viewKey) -> void;
+    auto prefetch(const Person& person, int space, int viewKey) -> void;
+    auto clearCache() -> void { cache_.clear(); }
+    auto holdCache(bool hold) -> void { cacheHeld_ = hold; }
+
+    auto computeFeatures(const std::vector<Person>& person, int space, int viewKey) -> std::vector<ChartFeatures>;
+    auto getFeatureStamp(int space, int viewKey) const -> qint64;
 
     auto getCoreForce(int view) const -> const CoreForce&;
     auto getPlanetStat() const -> const std::map<int, std::array<double, 2>>&;
@@ -46,6 +89,13 @@ private :
     const QLocale& locale_;
 
     QString headerStr_;
+    KernelCache cache_;
+    bool        cacheHeld_;
+
+private :
+    auto makeState() const -> KernelState;
+    auto loadState(KernelState state) -> void;
+    auto makeFeatures() const -> ChartFeatures;
 };
 
 } // namespace napatahti
@@ -0,0 +1,108 @@
+#include <QHash>
+#include "Person.h"
+#include "AspPage.h"
+#include "KernelCache.h"
+
+namespace napatahti {
+
+auto KernelState::size() const -> std::size_t
+{
+    // Rough estimate, a tree node costs about four pointers over its value
+    constexpr std::size_t node (4 * sizeof(void*));
+
+    auto size (sizeof(KernelState));
+    auto planets (astroBase.planetCrd.size());
+
+    size += planets * (8 * (node + 16) + 128);
+    size += (astroBase.jyotCal.size() + astroBase.westCal.size()) * (node + 16);
+    size += (astroBase.jyotCache.size() + astroBase.westCache.size()) * 64;
+
+    size += aspTable.planetX2Table.size() * (node + sizeof(std::pair<KeyPair, AspData>));
+    size += aspTable.planetStarTable.size() * (node + 128);
+    size += aspTable.aspCfgBone.size() * (node + 128);
+
+    for (auto& i : aspTable.aspSample)
+        size += i.size() * (node + sizeof(std::pair<KeyPair, const AspData*>));
+    for (auto& i : aspTable.aspCfgTable)
+        size += node + i.second.first.size() * (node + 64);
+    for (auto& i : aspTable.aspCfgSrc)
+        for (auto& j : i)
+            size += node + j.second.size() * (node + 64);
+
+    size += planets * 12 * (node + 24);
+
+    return size;
+}
+
+
+KernelCacheKey::KernelCacheKey(const Person& person, int space, int accKey, int viewKey)
+    : msecs (person.dateTime.toMSecsSinceEpoch())
+    , utc (person.dateTime.offsetFromUtc())
+    , lat (person.lat)
+    , lon (person.lon)
+    , hsys (person.hsys)
+    , patch (person.patch.toBlob())
+    , aspPage (AspPage::getTitle())
+    , space (space)
+    , accKey (accKey)
+    , viewKey (viewKey)
+{}
+
+
+auto KernelCacheKey::operator==(const KernelCacheKey& rhs) const -> bool
+{
+    return
+        msecs == rhs.msecs && utc == rhs.utc && lat == rhs.lat && lon == rhs.lon &&
+        hsys == rhs.hsys && patch == rhs.patch && aspPage == rhs.aspPage &&
+        space == rhs.space && accKey == rhs.accKey && viewKey == rhs.viewKey;
+}
+
+
+auto KernelCacheHash::operator()(const KernelCacheKey& key) const -> std::size_t
+{
+    return qHashMulti(
+        0, key.msecs, key.utc, key.lat, key.lon, key.hsys,
+        key.patch, key.aspPage, key.space, key.accKey, key.viewKey);
+}
+
+
+auto KernelCache::find(const KernelCacheKey& key) -> const KernelState*
+{
+    auto check (index_.find(key));
+    if (check == index_.end())
+        return nullptr;
+
+    list_.splice(list_.begin(), list_, check->second);
+    return &check->second->second;
+}
+
+
+auto KernelCache::insert(const KernelCacheKey& key, KernelState state) -> void
+{
+    auto size (state.size());
+    auto capacity (static_cast<std::size_t>(capacity_) << 20);
+
+    if (size > capacity || index_.find(key) != index_.end())
+        return;
+
+    while (!list_.empty() && size_ + size > capacity)
+    {
+        size_ -= list_.back().second.size();
+        index_.erase(list_.back().first);
+        list_.pop_back();
+    }
+
+    list_.emplace_front(key, std::move(state));
+    index_.emplace(key, list_.begin());
+    size_ += size;
+}
+
+
+auto KernelCache::clear() -> void
+{
+    list_.clear();
+    index_.clear();
+    size_ = 0;
+}
+
+} // namespace napatahti
@@ -0,0 +1,78 @@
+#ifndef KERNELCACHE_H
+#define KERNELCACHE_H
+
+#include <list>
+#include <unordered_map>
+#include "AstroBase.h"
+#include "AspTable.h"
+#include "PrimeTest.h"
+#include "AshaTest.h"
+#include "CosmicTest.h"
+
+namespace napatahti {
+
+class Person;
+class ConfigDialog;
+
+
+struct KernelState {
+    AstroBase::State  astroBase;
+    AspTable::State   aspTable;
+    PrimeTest::State  primeTest;
+    AshaTest::State   ashaTest;
+    CosmicTest::State cosmicTest;
+
+    auto size() const -> std::size_t;
+};
+
+
+struct KernelCacheKey {
+    KernelCacheKey(const Person& person, int space, int accKey, int viewKey);
+
+    qint64     msecs;
+    int        utc;
+    int        lat;
+    int        lon;
+    int        hsys;
+    QByteArray patch;
+    QString    aspPage;
+    int        space;
+    int        accKey;
+    int        viewKey;
+
+    auto operator==(const KernelCacheKey& rhs) const -> bool;
+};
+
+
+struct KernelCacheHash {
+    auto operator()(const KernelCacheKey& key) const -> std::size_t;
+};
+
+
+class KernelCache
+{
+public :
+    explicit KernelCache() : size_ (0) {}
+
+    auto find(const KernelCacheKey& key) -> const KernelState*;
+    auto contains(const KernelCacheKey& key) const { return index_.find(key) != index_.end(); }
+    auto insert(const KernelCacheKey& key, KernelState state) -> void;
+    auto clear() -> void;
+
+    static auto getCapacity() { return capacity_; }
+
+private :
+    using entry_list_t = std::list<std::pair<KernelCacheKey, KernelState>>;
+
+    entry_list_t list_;
+    std::unordered_map<KernelCacheKey, entry_list_t::iterator, KernelCacheHash> index_;
+    std::size_t  size_;
+
+    static int capacity_;
+
+    friend ConfigDialog;
+};
+
+} // namespace napatahti
+
+#endif // KERNELCACHE_H
@@ -3,6 +3,7 @@
 
 #include <QDateTime>
 #include <QSqlQuery>
+#include "AspPatch.h"
 
 namespace napatahti {
 
@@ -32,7 +33,7 @@ public :
         int              lat,
         int              lon,
         int              hsys,
-        const QString&   patch,
+        const AspPatch&  patch,
         const QString&   table
         )
         : name (name)
@@ -54,7 +55,7 @@ public :
         , lat (query.value("lat").toInt())
         , lon (query.value("lon").toInt())
         , hsys (query.value("hsys").toInt())
-        , patch (query.value("patch").toString())
+        , patch (query.value("patch"))
         , table (table)
     {}
 
@@ -82,7 +83,7 @@ public :
     int       lat;
     int       lon;
     int       hsys;
-    QString   patch;
+    AspPatch  patch;
     QString   table;
 
 private :
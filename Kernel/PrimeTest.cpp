@@ -81,6 +81,22 @@ auto PrimeTest::update() -> void
 }
 
 
+auto PrimeTest::saveState() const -> State
+{
+    return {coreStat_, primeStat_, primeFict_, mapType_, almuten_};
+}
+
+
+auto PrimeTest::loadState(State state) -> void
+{
+    coreStat_ = std::move(state.coreStat);
+    primeStat_ = std::move(state.primeStat);
+    primeFict_ = std::move(state.primeFict);
+    mapType_ = std::move(state.mapType);
+    almuten_ = std::move(state.almuten);
+}
+
+
 auto PrimeTest::computeCoreStat(int method, int view) -> void
 {
     auto& planetSiteNo (view == 0 ? astroBase_.getPlanetSignNo() : astroBase_.getPlanetHouseNo());
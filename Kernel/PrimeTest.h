@@ -110,6 +110,15 @@ struct PrimeFict {
 
 class PrimeTest
 {
+public :
+    struct State {
+        CoreStat  coreStat;
+        PrimeStat primeStat;
+        PrimeFict primeFict;
+        MapType   mapType;
+        std::map<std::array<int, 2>, bool> almuten;
+    };
+
 public :
     explicit PrimeTest(const AstroBase& astroBase, const AspTable& aspTable)
         : astroBase_ (astroBase)
@@ -117,6 +126,8 @@ public :
     {}
 
     auto update() -> void;
+    auto saveState() const -> State;
+    auto loadState(State state) -> void;
 
     auto& getMapType(int view) const { return mapType_[view]; }
 
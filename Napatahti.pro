@@ -1,6 +1,8 @@
 QT += core gui
 QT += sql
+QT += concurrent
 QT += printsupport
+QT += svg
 
 greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
 
@@ -17,6 +19,7 @@ SOURCES += \
     Appgui/AspPageDialog.cpp \
     Appgui/AspPatchDialog.cpp \
     Appgui/AspTableDialog.cpp \
+    Appgui/AspTimelineView.cpp \
     Appgui/Canvas.cpp \
     Appgui/CanvasBase.cpp \
     Appgui/CatalogDialog.cpp \
@@ -27,17 +30,29 @@ SOURCES += \
     Appgui/TCounterDialog.cpp \
     Kernel/AshaTest.cpp \
     Kernel/AspPage.cpp \
+    Kernel/AspPatch.cpp \
     Kernel/AspTable.cpp \
+    Kernel/AspTimeline.cpp \
     Kernel/AstroBase.cpp \
     Kernel/CosmicTest.cpp \
     Kernel/Kernel.cpp \
+    Kernel/KernelCache.cpp \
     Kernel/Person.cpp \
     Appgui/SharedGui.cpp \
+    Appgui/SqlConnection.cpp \
     Appgui/AtlasDialog.cpp \
+    Appgui/ChartRender.cpp \
     Appgui/CityDialog.cpp \
+    Appgui/CityImport.cpp \
+    Appgui/ImportBase.cpp \
+    Appgui/CityModel.cpp \
     Appgui/DataBaseDialog.cpp \
+    Appgui/FeatureIndex.cpp \
     Appgui/LineEditDialog.cpp \
     Appgui/PersonDialog.cpp \
+    Appgui/PersonImport.cpp \
+    Appgui/PersonModel.cpp \
+    Appgui/PersonQuery.cpp \
     Kernel/PrimeTest.cpp \
     shared.cpp \
     main.cpp \
@@ -50,6 +65,7 @@ HEADERS += \
     Appgui/AspPageDialog.h \
     Appgui/AspPatchDialog.h \
     Appgui/AspTableDialog.h \
+    Appgui/AspTimelineView.h \
     Appgui/Canvas.h \
     Appgui/CanvasBase.h \
     Appgui/CatalogDialog.h \
@@ -60,17 +76,30 @@ HEADERS += \
     Appgui/TCounterDialog.h \
     Kernel/AshaTest.h \
     Kernel/AspPage.h \
+    Kernel/AspPatch.h \
     Kernel/AspTable.h \
+    Kernel/AspTimeline.h \
     Kernel/AstroBase.h \
     Kernel/CosmicTest.h \
     Kernel/Kernel.h \
+    Kernel/KernelCache.h \
     Kernel/Person.h \
     Appgui/AtlasDialog.h \
+    Appgui/ChartRender.h \
     Appgui/CityDialog.h \
+    Appgui/CityImport.h \
+    Appgui/ImportBase.h \
+    Appgui/CityModel.h \
     Appgui/DataBaseDialog.h \
+    Appgui/FeatureIndex.h \
     Appgui/LineEditDialog.h \
+    Appgui/PagedModel.h \
     Appgui/PersonDialog.h \
+    Appgui/PersonImport.h \
+    Appgui/PersonModel.h \
+    Appgui/PersonQuery.h \
     Appgui/SharedGui.h \
+    Appgui/SqlConnection.h \
     Kernel/PrimeTest.h \
     Kernel/RefBook.h \
     mask.h \
@@ -12,10 +12,12 @@ struct KernelMask { enum Key {
     PrimeTest    = 32,
     AshaTest     = 64,
     CosmicTest   = 128,
+    Cached       = 256,
 
     AspPageFull   = AspTable | PrimeTest | CosmicTest,
     PlanetCatFull = Coupling | AspCfg,
     AspTableFull  = AspTable | PrimeTest | CosmicTest,
+    AspTablePair  = PrimeTest | CosmicTest,
     MapViewAcc    = AspTable | CosmicTest
 };};
 
@@ -7,6 +7,7 @@
 #include "Kernel/AspPage.h"
 #include "Kernel/AspTable.h"
 #include "Kernel/PrimeTest.h"
+#include "Kernel/KernelCache.h"
 #include "Appgui/MainWindow.h"
 #include "Appgui/Canvas.h"
 #include "Appgui/SharedGui.h"
@@ -14,6 +15,13 @@
 #include "Appgui/AtlasDialog.h"
 #include "Appgui/PersonDialog.h"
 #include "Appgui/DataBaseDialog.h"
+#include "Appgui/PersonModel.h"
+#include "Appgui/PersonQuery.h"
+#include "Appgui/CityModel.h"
+#include "Appgui/CityImport.h"
+#include "Appgui/FeatureIndex.h"
+#include "Appgui/SqlConnection.h"
+#include "Appgui/PersonImport.h"
 #include "Appgui/AspPageDialog.h"
 #include "Appgui/AspDialog.h"
 #include "Appgui/AspTableDialog.h"
@@ -261,6 +269,10 @@ const PrimeInd PrimeTest::primeInd_ {};
 
 //---------------------------------------------------------------------------//
 
+int KernelCache::capacity_;
+
+//---------------------------------------------------------------------------//
+
 AppTrigger MainWindow::trigger_;
 
 //---------------------------------------------------------------------------//
@@ -295,11 +307,30 @@ const QRegularExpression CityDialog::lonReg {
 
 //---------------------------------------------------------------------------//
 
+const AtlasDialog::SqlMask AtlasDialog::mask_;
 QString AtlasDialog::dbaseName_;
 QVariantMap AtlasDialog::newCity_;
 
 //---------------------------------------------------------------------------//
 
+const CityModel::SqlMask CityModel::mask_;
+
+const std::array<QString, 4> CityModel::sortKey_ {"title", "utc", "lat", "lon"};
+
+const std::array<const char*, 4> CityModel::header_ {
+    QT_TRANSLATE_NOOP("AtlasDialog", "Title"),
+    QT_TRANSLATE_NOOP("AtlasDialog", "Time zone"),
+    QT_TRANSLATE_NOOP("AtlasDialog", "Latitude"),
+    QT_TRANSLATE_NOOP("AtlasDialog", "Longitude")};
+
+//---------------------------------------------------------------------------//
+
+const CityImport::SqlMask CityImport::mask_;
+const QString CityImport::countryFile_ {"countryInfo.txt"};
+const QString CityImport::adminFile_ {"admin1CodesASCII.txt"};
+
+//---------------------------------------------------------------------------//
+
 QSize PersonDialog::atlasSize_;
 int PersonDialog::leftMgn_;
 int PersonDialog::topMgn_;
@@ -323,6 +354,53 @@ const QRegularExpression DataBaseDialog::tableReg_ {"^([a-z]|[A-Z])\\w+$"};
 
 //---------------------------------------------------------------------------//
 
+const QStringList SqlConnection::pragma_ {
+    "PRAGMA journal_mode=WAL;",
+    "PRAGMA synchronous=NORMAL;",
+    "PRAGMA temp_store=MEMORY;",
+    "PRAGMA cache_size=-16384;",
+    "PRAGMA mmap_size=67108864;",
+    "PRAGMA foreign_keys=ON;"};
+
+const QStringList SqlConnection::tokenizer_ {"trigram remove_diacritics 1", "trigram"};
+
+const SqlConnection::IndexMask SqlConnection::indexMask_;
+
+//---------------------------------------------------------------------------//
+
+const PersonModel::SqlMask PersonModel::mask_;
+
+const std::array<QString, 10> PersonModel::sortKey_ {
+    "name", "dateTime", "substr(dateTime, 12)", "substr(dateTime, 24)", "sex",
+    "lat", "lon", "location", "hsys", "ifnull(length(patch), 0) > 0"};
+
+const QStringList PersonModel::indexColumn_ {"name", "location"};
+
+const FeatureIndex::SqlMask FeatureIndex::mask_;
+
+const PersonQuery::SqlMask PersonQuery::mask_;
+
+const std::array<QString, 12> PersonQuery::signName_ {
+    "Aries", "Taurus", "Gemini", "Cancer", "Leo", "Virgo",
+    "Libra", "Scorpio", "Sagittarius", "Capricorn", "Aquarius", "Pisces"};
+
+const std::map<QString, QString> PersonQuery::compare_ {
+    {"==", "="}, {"!=", "<>"}, {"<", "<"}, {"<=", "<="}, {">", ">"}, {">=", ">="}};
+
+const std::array<const char*, 10> PersonModel::header_ {
+    QT_TRANSLATE_NOOP("DataBaseDialog", "Name"),
+    QT_TRANSLATE_NOOP("DataBaseDialog", "Date"),
+    QT_TRANSLATE_NOOP("DataBaseDialog", "Time"),
+    QT_TRANSLATE_NOOP("DataBaseDialog", "Time zone"),
+    QT_TRANSLATE_NOOP("DataBaseDialog", "Sex"),
+    QT_TRANSLATE_NOOP("DataBaseDialog", "Latitude"),
+    QT_TRANSLATE_NOOP("DataBaseDialog", "Longitude"),
+    QT_TRANSLATE_NOOP("DataBaseDialog", "Location"),
+    QT_TRANSLATE_NOOP("DataBaseDialog", "Hsys"),
+    QT_TRANSLATE_NOOP("DataBaseDialog", "Patch")};
+
+//---------------------------------------------------------------------------//
+
 QString AspPageDialog::sampPath_;
 std::array<QBrush, 2> AspPageDialog::brushED_;
 QPen LineDelegate::markPen_;
@@ -337,6 +415,25 @@ const std::map<int, QColor> AspDialog::baseColor_ {
 
 //---------------------------------------------------------------------------//
 
+int ImportBase::batch_;
+
+const PersonImport::SqlMask PersonImport::mask_;
+
+const std::array<QStringList, PersonImport::Field::Count> PersonImport::alias_ {{
+    {"name"},
+    {"datetime"},
+    {"date", "birthdate"},
+    {"time", "birthtime"},
+    {"utc", "tz", "offset"},
+    {"sex", "gender"},
+    {"location", "city", "place"},
+    {"lat", "latitude"},
+    {"lon", "lng", "longitude"},
+    {"hsys"},
+    {"patch"}}};
+
+//---------------------------------------------------------------------------//
+
 std::array<QBrush, 3> AspTableDialog::brush_;
 
 //---------------------------------------------------------------------------//